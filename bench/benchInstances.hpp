@@ -0,0 +1,72 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <utility>
+
+#include "compiledInstance.hpp"
+#include "jobShopInstance.hpp"
+#include "random.hpp"
+
+namespace scheduling::bench {
+
+// master seed of the generated instances and of every benchmark's random
+// stream, so that runs of different builds measure the same work
+constexpr std::uint64_t SEED = 20240601;
+
+// reset the calling thread's random stream, before each benchmark
+inline void reseed()
+{
+    set_master_seed(SEED);
+    set_thread_stream(0);
+}
+
+// jobs x machines instance of the size matrix, generated once per size
+inline const JobShopInstance& instance(int num_jobs, int num_machines)
+{
+    static std::map<std::pair<int, int>, std::unique_ptr<JobShopInstance>>
+        instances;
+    auto& generated = instances[{num_jobs, num_machines}];
+    if (generated == nullptr) {
+        reseed();
+        generated = std::make_unique<JobShopInstance>();
+        generated->generate_instance(num_jobs, num_machines);
+    }
+    return *generated;
+}
+
+inline const CompiledInstance& compiled_instance(int num_jobs,
+                                                 int num_machines)
+{
+    static std::map<std::pair<int, int>, std::unique_ptr<CompiledInstance>>
+        instances;
+    auto& compiled = instances[{num_jobs, num_machines}];
+    if (compiled == nullptr) {
+        compiled = std::make_unique<CompiledInstance>(
+            instance(num_jobs, num_machines));
+    }
+    return *compiled;
+}
+
+// the benchmarked sizes, jobs x machines
+inline void size_matrix(benchmark::internal::Benchmark* benchmark)
+{
+    benchmark->ArgNames({"jobs", "machines"});
+    benchmark->Args({10, 10});
+    benchmark->Args({20, 20});
+    benchmark->Args({50, 20});
+    benchmark->Args({100, 20});
+    benchmark->Args({500, 50});
+}
+
+// operations per second, to compare sizes
+inline void set_ops_processed(benchmark::State& state, size_t num_ops)
+{
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+                            static_cast<int64_t>(num_ops));
+}
+
+}   // namespace scheduling::bench
@@ -0,0 +1,186 @@
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "algorithm.hpp"
+#include "batchDecoder.hpp"
+#include "benchInstances.hpp"
+#include "compiledInstance.hpp"
+#include "decoder.hpp"
+#include "types.hpp"
+
+namespace {
+
+using scheduling::GAAlgorithm;
+namespace bench = scheduling::bench;
+
+void BM_Decode(benchmark::State& state)
+{
+    const auto& instance =
+        bench::compiled_instance(state.range(0), state.range(1));
+    bench::reseed();
+    const auto individual = GAAlgorithm::encode(instance);
+
+    for (auto _ : state) {
+        auto solution = GAAlgorithm::decode(individual.chromosome, instance);
+        benchmark::DoNotOptimize(solution.makespan);
+    }
+    bench::set_ops_processed(state, instance.num_ops());
+}
+BENCHMARK(BM_Decode)->Apply(bench::size_matrix);
+
+void BM_DecodeMakespan(benchmark::State& state)
+{
+    const auto& instance =
+        bench::compiled_instance(state.range(0), state.range(1));
+    bench::reseed();
+    const auto individual = GAAlgorithm::encode(instance);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            scheduling::decode_makespan(individual.chromosome, instance));
+    }
+    bench::set_ops_processed(state, instance.num_ops());
+}
+BENCHMARK(BM_DecodeMakespan)->Apply(bench::size_matrix);
+
+// the decode of shapes without a specialized kernel, to compare with
+void BM_DecodeMakespanGeneric(benchmark::State& state)
+{
+    const auto& instance =
+        bench::compiled_instance(state.range(0), state.range(1));
+    bench::reseed();
+    const auto individual = GAAlgorithm::encode(instance);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(scheduling::decode_makespan_generic(
+            individual.chromosome, instance));
+    }
+    bench::set_ops_processed(state, instance.num_ops());
+}
+BENCHMARK(BM_DecodeMakespanGeneric)->Apply(bench::size_matrix);
+
+// makespans of a population of 64, in batches of the isa's lanes
+void BM_DecodeBatch(benchmark::State& state, scheduling::DecodeIsa isa)
+{
+    const auto& instance =
+        bench::compiled_instance(state.range(0), state.range(1));
+    if (!scheduling::decode_isa_supported(isa)) {
+        state.SkipWithError("isa not supported");
+        return;
+    }
+    bench::reseed();
+    std::vector<scheduling::Chromosome>         population;
+    std::vector<scheduling::ConstChromosomeRef> chromosomes;
+    for (int i = 0; i < 64; ++i) {
+        population.push_back(GAAlgorithm::encode(instance).chromosome);
+    }
+    for (const auto& chromosome : population) {
+        chromosomes.emplace_back(chromosome);
+    }
+    std::vector<scheduling::Fitness> makespans(chromosomes.size());
+
+    for (auto _ : state) {
+        scheduling::decode_makespan_batch(
+            chromosomes, instance, makespans, isa);
+        benchmark::DoNotOptimize(makespans.data());
+    }
+    bench::set_ops_processed(state, instance.num_ops() * chromosomes.size());
+}
+BENCHMARK_CAPTURE(BM_DecodeBatch, scalar, scheduling::DecodeIsa::SCALAR)
+    ->Apply(bench::size_matrix);
+BENCHMARK_CAPTURE(BM_DecodeBatch, avx2, scheduling::DecodeIsa::AVX2)
+    ->Apply(bench::size_matrix);
+BENCHMARK_CAPTURE(BM_DecodeBatch, avx512, scheduling::DecodeIsa::AVX512)
+    ->Apply(bench::size_matrix);
+
+// random chromosome and its makespan
+void BM_Encode(benchmark::State& state)
+{
+    const auto& instance =
+        bench::compiled_instance(state.range(0), state.range(1));
+    bench::reseed();
+
+    for (auto _ : state) {
+        auto individual = GAAlgorithm::encode(instance);
+        benchmark::DoNotOptimize(individual.fitness);
+    }
+    bench::set_ops_processed(state, instance.num_ops());
+}
+BENCHMARK(BM_Encode)->Apply(bench::size_matrix);
+
+// chromosome of a decoded schedule
+void BM_EncodeSolution(benchmark::State& state)
+{
+    const auto& instance =
+        bench::compiled_instance(state.range(0), state.range(1));
+    bench::reseed();
+    const auto solution =
+        GAAlgorithm::decode(GAAlgorithm::encode(instance).chromosome, instance);
+
+    for (auto _ : state) {
+        auto individual = GAAlgorithm::encode(solution);
+        benchmark::DoNotOptimize(individual.chromosome.data());
+    }
+    bench::set_ops_processed(state, instance.num_ops());
+}
+BENCHMARK(BM_EncodeSolution)->Apply(bench::size_matrix);
+
+void BM_Crossover(benchmark::State& state)
+{
+    const auto& instance =
+        bench::compiled_instance(state.range(0), state.range(1));
+    bench::reseed();
+    const auto parent1 = GAAlgorithm::encode(instance);
+    const auto parent2 = GAAlgorithm::encode(instance);
+    scheduling::Chromosome child1(parent1.chromosome.size());
+    scheduling::Chromosome child2(parent1.chromosome.size());
+
+    for (auto _ : state) {
+        GAAlgorithm::crossover(
+            parent1.chromosome, parent2.chromosome, child1, child2);
+        benchmark::DoNotOptimize(child1.data());
+        benchmark::DoNotOptimize(child2.data());
+    }
+    bench::set_ops_processed(state, instance.num_ops());
+}
+BENCHMARK(BM_Crossover)->Apply(bench::size_matrix);
+
+// mutation includes the decode of the mutated chromosome
+void BM_Mutation(benchmark::State& state)
+{
+    const auto& instance =
+        bench::compiled_instance(state.range(0), state.range(1));
+    bench::reseed();
+    auto individual = GAAlgorithm::encode(instance);
+
+    for (auto _ : state) {
+        GAAlgorithm::mutation(individual, instance);
+        benchmark::DoNotOptimize(individual.fitness);
+    }
+    bench::set_ops_processed(state, instance.num_ops());
+}
+BENCHMARK(BM_Mutation)->Apply(bench::size_matrix);
+
+// one tournament in a population of 100
+void BM_TournamentSelection(benchmark::State& state)
+{
+    const auto& instance =
+        bench::compiled_instance(state.range(0), state.range(1));
+    bench::reseed();
+    std::vector<scheduling::Fitness> fitness;
+    for (int i = 0; i < 100; ++i) {
+        fitness.push_back(GAAlgorithm::encode(instance).fitness);
+    }
+
+    for (auto _ : state) {
+        auto selected = GAAlgorithm::tournament_selection(fitness);
+        benchmark::DoNotOptimize(selected);
+    }
+    bench::set_ops_processed(state, instance.num_ops());
+}
+BENCHMARK(BM_TournamentSelection)->Apply(bench::size_matrix);
+
+}   // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,49 @@
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "benchInstances.hpp"
+#include "solutionConstructor.hpp"
+#include "types.hpp"
+
+namespace {
+
+namespace bench = scheduling::bench;
+
+// one randomized schedule, start times only (the GRASP inner loop)
+void BM_Schedule(benchmark::State& state)
+{
+    const auto& instance =
+        bench::compiled_instance(state.range(0), state.range(1));
+    bench::reseed();
+    scheduling::SolutionConstructor constructor;
+    constructor.convert_from_instance(instance);
+    std::vector<scheduling::TimeStamp> start_times;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(constructor.schedule(start_times));
+    }
+    bench::set_ops_processed(state, instance.num_ops());
+}
+BENCHMARK(BM_Schedule)->Apply(bench::size_matrix);
+
+// one randomized schedule as a Solution
+void BM_ScheduleSolution(benchmark::State& state)
+{
+    const auto& instance =
+        bench::compiled_instance(state.range(0), state.range(1));
+    bench::reseed();
+    scheduling::SolutionConstructor constructor;
+    constructor.convert_from_instance(instance);
+
+    for (auto _ : state) {
+        auto solution = constructor.schedule();
+        benchmark::DoNotOptimize(solution.makespan);
+    }
+    bench::set_ops_processed(state, instance.num_ops());
+}
+BENCHMARK(BM_ScheduleSolution)->Apply(bench::size_matrix);
+
+}   // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,270 @@
+// End-to-end quality-vs-time benchmark of the solver.
+//
+// Runs the portfolio (or one algorithm) on every instance of a directory,
+// for every seed and thread count, records the incumbent makespan over
+// time, and reports per run the final makespan, the gap to the best known
+// makespan, the primal integral and the time to target, as CSV (one line
+// per run) and JSON (the runs with their traces).
+//
+// usage:
+//     ./bench_solver --instances=<dir or file> --best_known=<file>
+//         --seeds=1,2,3 --threads=1,4 --time_limit=10 --output=results
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "absl/flags/flag.h"
+#include "absl/flags/parse.h"
+#include "absl/flags/usage.h"
+
+#include "decoder.hpp"
+#include "instanceLoader.hpp"
+#include "jobShopInstance.hpp"
+#include "qualityTrace.hpp"
+#include "random.hpp"
+#include "run.hpp"
+#include "types.hpp"
+
+ABSL_FLAG(std::string, instances, "",
+          "Instance file, or directory of instance files (OR-Library, "
+          "Taillard or JSON)");
+ABSL_FLAG(std::string, best_known, "",
+          "File of \"<instance name> <best known makespan>\" lines");
+ABSL_FLAG(std::vector<std::string>, seeds, {"1"}, "Master seeds, one run each");
+ABSL_FLAG(std::vector<std::string>, threads, {"4"},
+          "Thread counts, one run each");
+ABSL_FLAG(int, time_limit, 10, "Time limit of each run, in seconds");
+ABSL_FLAG(std::string, algorithm, "portfolio",
+          "portfolio, ga, tabu, cp_sat or lns");
+ABSL_FLAG(int, grasp_starts, 100, "Number of GRASP starts of each run");
+ABSL_FLAG(std::string, decode_mode, "semi_active",
+          "Decoder of the GA: semi_active, active or giffler_thompson");
+ABSL_FLAG(double, decode_delay, 1.0, "Giffler-Thompson delay in [0, 1]");
+ABSL_FLAG(double, target_gap, 0.01,
+          "Time to target is the time to reach best known * (1 + gap)");
+ABSL_FLAG(std::string, output, "bench_solver",
+          "Output prefix, writes <prefix>.csv and <prefix>.json");
+
+namespace {
+
+using scheduling::Fitness;
+using scheduling::QualityTrace;
+
+struct RunRecord
+{
+    std::string                      instance;
+    size_t                           num_jobs;
+    size_t                           num_machines;
+    int                              num_threads;
+    std::uint64_t                    seed;
+    double                           wall_time;
+    Fitness                          lower_bound;
+    std::vector<QualityTrace::Point> trace;
+};
+
+std::vector<std::filesystem::path> instance_files(const std::string& path)
+{
+    std::vector<std::filesystem::path> files;
+    if (std::filesystem::is_directory(path)) {
+        for (const auto& entry : std::filesystem::directory_iterator(path)) {
+            if (entry.is_regular_file()) {
+                files.push_back(entry.path());
+            }
+        }
+        std::ranges::sort(files);
+    }
+    else {
+        files.emplace_back(path);
+    }
+    return files;
+}
+
+std::map<std::string, Fitness> read_best_known(const std::string& path)
+{
+    std::map<std::string, Fitness> best_known;
+    if (path.empty()) {
+        return best_known;
+    }
+    std::ifstream in(path);
+    if (!in) {
+        throw std::runtime_error(path + ": cannot open");
+    }
+    std::string name;
+    Fitness     makespan = 0;
+    while (in >> name >> makespan) {
+        best_known[name] = makespan;
+    }
+    return best_known;
+}
+
+RunRecord solve(const std::filesystem::path& file,
+                const scheduling::JobShopInstance& instance, int num_threads,
+                std::uint64_t seed)
+{
+    scheduling::set_master_seed(seed);
+    scheduling::set_thread_stream(0);
+
+    scheduling::Run run{instance, num_threads, absl::GetFlag(FLAGS_time_limit)};
+    run.set_grasp_starts(absl::GetFlag(FLAGS_grasp_starts));
+    run.set_decode_mode(
+        scheduling::parse_decode_mode(absl::GetFlag(FLAGS_decode_mode)),
+        absl::GetFlag(FLAGS_decode_delay));
+    const std::string algorithm = absl::GetFlag(FLAGS_algorithm);
+    if (algorithm == "ga") {
+        run.add_ga_algorithm(num_threads);
+    }
+    else if (algorithm == "tabu") {
+        run.add_tabu_search_algorithm(num_threads);
+    }
+    else if (algorithm == "cp_sat") {
+        run.add_cp_sat_algorithm(num_threads);
+    }
+    else if (algorithm == "lns") {
+        run.add_lns_algorithm(num_threads);
+    }
+    else if (algorithm != "portfolio") {
+        throw std::runtime_error("unknown algorithm: " + algorithm);
+    }
+
+    QualityTrace trace;
+    run.incumbent().set_observer(
+        [&trace](Fitness makespan) { trace.record(makespan); });
+    trace.start();
+    run();
+
+    return RunRecord{file.stem().string(),
+                     instance.jobs().size(),
+                     instance.machines().size(),
+                     num_threads,
+                     seed,
+                     trace.elapsed(),
+                     run.incumbent().lower_bound(),
+                     trace.points()};
+}
+
+// "null" for a missing value
+template<typename T> std::string json_value(const std::optional<T>& value)
+{
+    return value ? std::to_string(*value) : "null";
+}
+
+}   // namespace
+
+int main(int argc, char** argv)
+{
+    absl::SetProgramUsageMessage(
+        "Quality-vs-time benchmark of the job shop solver.\n"
+        "Usage:\n"
+        "    ./bench_solver --instances=<dir> --best_known=<file> "
+        "--seeds=1,2,3 --threads=1,4 --time_limit=<int> --output=<prefix>");
+    absl::ParseCommandLine(argc, argv);
+
+    std::vector<RunRecord>         records;
+    std::map<std::string, Fitness> best_known;
+    try {
+        best_known = read_best_known(absl::GetFlag(FLAGS_best_known));
+        for (const auto& file :
+             instance_files(absl::GetFlag(FLAGS_instances))) {
+            scheduling::JobShopInstance instance;
+            scheduling::load_instance(file.string(), instance);
+            for (const std::string& threads : absl::GetFlag(FLAGS_threads)) {
+                for (const std::string& seed : absl::GetFlag(FLAGS_seeds)) {
+                    records.push_back(solve(file,
+                                            instance,
+                                            std::stoi(threads),
+                                            std::stoull(seed)));
+                }
+            }
+        }
+    }
+    catch (const std::exception& error) {
+        std::cerr << error.what() << '\n';
+        return 1;
+    }
+
+    // without a best known makespan, the reference is the best of all runs
+    std::map<std::string, Fitness> reference = best_known;
+    for (const RunRecord& record : records) {
+        if (best_known.contains(record.instance)) {
+            continue;
+        }
+        if (auto makespan = QualityTrace::final_makespan(record.trace)) {
+            auto [it, inserted] = reference.emplace(record.instance, *makespan);
+            it->second          = std::min(it->second, *makespan);
+        }
+    }
+
+    const std::string output = absl::GetFlag(FLAGS_output);
+    std::ofstream     csv(output + ".csv");
+    std::ofstream     json(output + ".json");
+    csv << "instance,jobs,machines,threads,seed,time_limit,wall_time,"
+           "makespan,lower_bound,reference,best_known,gap,primal_integral,"
+           "time_to_target\n";
+    json << "{\"time_limit\": " << absl::GetFlag(FLAGS_time_limit)
+         << ", \"algorithm\": \"" << absl::GetFlag(FLAGS_algorithm)
+         << "\", \"target_gap\": " << absl::GetFlag(FLAGS_target_gap)
+         << ", \"runs\": [";
+    csv << std::setprecision(6);
+    json << std::setprecision(6);
+
+    for (size_t i = 0; i < records.size(); ++i) {
+        const RunRecord& record    = records[i];
+        const auto       makespan  = QualityTrace::final_makespan(record.trace);
+        const bool       has_known = best_known.contains(record.instance);
+        const auto       found     = reference.find(record.instance);
+        const Fitness    ref = found != reference.end() ? found->second : 0;
+
+        std::optional<double> gap;
+        if (makespan && ref > 0) {
+            gap = (static_cast<double>(*makespan) - ref) / ref;
+        }
+        const double integral = QualityTrace::primal_integral(
+            record.trace, ref, record.wall_time);
+        const auto target = static_cast<Fitness>(
+            ref * (1.0 + absl::GetFlag(FLAGS_target_gap)));
+        const auto to_target =
+            QualityTrace::time_to_target(record.trace, target);
+
+        csv << record.instance << ',' << record.num_jobs << ','
+            << record.num_machines << ',' << record.num_threads << ','
+            << record.seed << ',' << absl::GetFlag(FLAGS_time_limit) << ','
+            << record.wall_time << ',' << (makespan ? *makespan : 0) << ','
+            << record.lower_bound << ',' << ref << ',' << has_known << ','
+            << (gap ? std::to_string(*gap) : "") << ',' << integral << ','
+            << (to_target ? std::to_string(*to_target) : "") << '\n';
+
+        json << (i == 0 ? "" : ",") << "\n  {\"instance\": \""
+             << record.instance << "\", \"jobs\": " << record.num_jobs
+             << ", \"machines\": " << record.num_machines
+             << ", \"threads\": " << record.num_threads
+             << ", \"seed\": " << record.seed
+             << ", \"wall_time\": " << record.wall_time
+             << ", \"makespan\": " << json_value(makespan)
+             << ", \"lower_bound\": " << record.lower_bound
+             << ", \"reference\": " << ref
+             << ", \"best_known\": " << (has_known ? "true" : "false")
+             << ", \"gap\": " << json_value(gap)
+             << ", \"primal_integral\": " << integral
+             << ", \"time_to_target\": " << json_value(to_target)
+             << ", \"trace\": [";
+        for (size_t j = 0; j < record.trace.size(); ++j) {
+            json << (j == 0 ? "" : ", ") << '[' << record.trace[j].seconds
+                 << ", " << record.trace[j].makespan << ']';
+        }
+        json << "]}";
+    }
+    json << "\n]}\n";
+
+    std::cout << records.size() << " runs written to " << output
+              << ".csv and " << output << ".json\n";
+    return 0;
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <vector>
+
+namespace scheduling {
+
+// Pin the calling thread to one cpu. Returns false when the platform has no
+// thread affinity support (e.g. macOS) or the call fails, the thread then
+// keeps running unpinned.
+bool pin_current_thread(int cpu);
+
+// Ids of the cpus the process may run on.
+std::vector<int> available_cpus();
+
+}   // namespace scheduling
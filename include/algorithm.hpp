@@ -1,13 +1,32 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <iostream>
+#include <memory>
 #include <mutex>
-#include <shared_mutex>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <utility>
 #include <vector>
 
+#include "affinity.hpp"
+#include "batchDecoder.hpp"
+#include "compiledInstance.hpp"
+#include "decoder.hpp"
+#include "disjunctiveGraph.hpp"
+#include "incumbent.hpp"
 #include "jobShopInstance.hpp"
+#include "mailbox.hpp"
+#include "populationArena.hpp"
+#include "random.hpp"
 #include "solution.hpp"
 #include "solutionConstructor.hpp"
+#include "threadPool.hpp"
 #include "types.hpp"
 
 namespace scheduling {
@@ -15,8 +34,74 @@ namespace scheduling {
 class Algorithm
 {
 protected:
-    int num_thread_{};
-    int time_limit_{};
+    int                       num_thread_{};
+    std::chrono::milliseconds time_limit_{};
+    std::uint64_t             random_stream_{};
+    std::vector<int>          cpu_set_;
+    ThreadPool*               pool_ = nullptr;   // shared task pool, or null
+    Population                seeds_;            // starting points, best first
+
+    // seed the calling worker thread's engine from the algorithm's stream,
+    // and pin the thread to its cpu when the algorithm has a cpu set (the
+    // workers of the shared pool are pinned by the pool)
+    void init_worker(int worker) const
+    {
+        set_thread_stream(worker_stream(worker));
+        if (pool_ == nullptr && !cpu_set_.empty()) {
+            pin_current_thread(cpu_set_[worker % cpu_set_.size()]);
+        }
+    }
+
+    // random stream id of a worker of the algorithm
+    std::uint64_t worker_stream(int worker) const
+    {
+        return (random_stream_ << 16) + worker + 1;
+    }
+
+    // Run body(worker, stop) for each of the num_threads() workers of the
+    // algorithm at the same time: as jobs of the shared pool, or on threads
+    // of their own without a pool. stop is set at the time limit or once
+    // the incumbent is proven optimal; returns when every worker returned.
+    void run_workers(
+        const Incumbent&                                         incumbent,
+        const std::function<void(int worker, std::atomic<bool>& stop)>& body)
+        const;
+
+    // run body(i) for i in [0, count) on the shared pool, or in the calling
+    // thread when the algorithm has no pool
+    void parallel_for(size_t count, const std::function<void(size_t)>& body,
+                      size_t grain = 1) const
+    {
+        if (pool_ != nullptr) {
+            pool_->parallel_for(count, body, grain);
+            return;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            body(i);
+        }
+    }
+
+    // disjunctive graph of the incumbent schedule, or of a random chromosome
+    // before the first publication
+    static DisjunctiveGraph start_graph(const CompiledInstance& instance,
+                                        const Incumbent&        incumbent);
+    // starting graph of a worker: its own seed while there are enough
+    // seeds, the incumbent otherwise
+    DisjunctiveGraph seed_graph(const CompiledInstance& instance,
+                                const Incumbent& incumbent, int worker) const;
+
+    // sleep until the time limit has passed, the incumbent is proven optimal
+    // or the optional finished flag is set, whichever comes first
+    void wait_for_time_limit(const Incumbent&         incumbent,
+                             const std::atomic<bool>* finished = nullptr) const
+    {
+        const auto deadline = std::chrono::steady_clock::now() + time_limit_;
+        while ((finished == nullptr || !finished->load()) &&
+               !incumbent.gap_closed() &&
+               std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    }
 
 public:
     Algorithm()                            = default;
@@ -26,11 +111,32 @@ public:
 
     Algorithm(int num_thread, int time_limit)
         : num_thread_(num_thread)
-        , time_limit_(time_limit)
+        , time_limit_(std::chrono::seconds(time_limit))
     {}
 
-    virtual void solve(const JobShopInstance& instance, Solution& global_best,
-                       std::shared_mutex& gbest_mtx) = 0;
+    int  num_threads() const { return num_thread_; }
+    void set_num_threads(int num_thread) { num_thread_ = num_thread; }
+    void set_time_limit(std::chrono::milliseconds time_limit)
+    {
+        time_limit_ = time_limit;
+    }
+    void set_random_stream(std::uint64_t stream) { random_stream_ = stream; }
+    void set_cpu_set(std::vector<int> cpu_set)
+    {
+        cpu_set_ = std::move(cpu_set);
+    }
+    void set_thread_pool(ThreadPool* pool) { pool_ = pool; }
+    // the workers run on the shared pool, false for algorithms that bring
+    // threads of their own
+    virtual bool uses_thread_pool() const { return true; }
+    // good, diverse starting points (e.g. the GRASP elite) for the
+    // populations and searches of the algorithm
+    void set_seeds(Population seeds) { seeds_ = std::move(seeds); }
+
+    // the compiled instance is shared read-only by all threads, improvements
+    // are published into the shared incumbent
+    virtual void solve(const CompiledInstance& instance,
+                       Incumbent&              incumbent) = 0;
 
     // del move semantics
     Algorithm(Algorithm&&)            = delete;
@@ -41,19 +147,75 @@ class GAAlgorithm : public Algorithm
 {
 
 public:
+    // islands that receive the emigrants of an island: the next one, or
+    // one picked at random at every migration
+    enum class Topology
+    {
+        RING,
+        RANDOM
+    };
+
     GAAlgorithm(int num_threads, int time_limit, int population_size = 100)
         : Algorithm(num_threads, time_limit)
-        , population_size_(population_size){};
+        , population_size_(static_cast<size_t>(population_size))
+    {
+        if (population_size < 1) {
+            throw std::invalid_argument("population size must be positive");
+        }
+    };
+
+    // every interval generations, each island sends copies of its size best
+    // individuals to another island
+    void set_migration(Topology topology, int interval, int size)
+    {
+        topology_           = topology;
+        migration_interval_ = interval;
+        migration_size_     = size;
+    }
+
+    // stop every island after that many generations, before the time limit
+    // (0: no limit)
+    void set_generation_limit(int generation_limit)
+    {
+        generation_limit_ = generation_limit;
+    }
+
+    // the last generation of each island of the last solve
+    const std::vector<Population>& populations() const { return populations_; }
+
+    // how the chromosomes are decoded, see DecodeMode; the delay is the one
+    // of the Giffler-Thompson decode
+    void set_decode_mode(DecodeMode mode, double delay = 1.0)
+    {
+        decode_mode_  = mode;
+        decode_delay_ = delay;
+    }
 
     static Individual encode(const Solution& solution);
     static Individual encode(const JobShopInstance& instance);
-    static Solution   decode(const Chromosome&      chromosome,
+    static Individual encode(const CompiledInstance& instance);
+    static Solution   decode(ConstChromosomeRef     chromosome,
                              const JobShopInstance& instance);
-    static Individual tournament_selection(const Population& population);
-    static std::pair<Chromosome, Chromosome> crossover(
-        const Individual& parent1, const Individual& parent2);
-    static void mutation(Individual&            individual,
-                         const JobShopInstance& instance);
+    static Solution   decode(ConstChromosomeRef      chromosome,
+                             const CompiledInstance& instance);
+    static Solution   decode(ConstChromosomeRef      chromosome,
+                             const CompiledInstance& instance, DecodeMode mode,
+                             double delay = 1.0);
+    // index of the best of a few random individuals
+    static size_t tournament_selection(std::span<const Fitness> fitness);
+    // the children are written in place, all four have the same size
+    static void    crossover(ConstChromosomeRef parent1,
+                             ConstChromosomeRef parent2, ChromosomeRef child1,
+                             ChromosomeRef child2);
+    // mutate in place, returns the fitness of the mutated chromosome
+    static Fitness mutation(ChromosomeRef           chromosome,
+                            const CompiledInstance& instance,
+                            DecodeMode mode  = DecodeMode::SEMI_ACTIVE,
+                            double     delay = 1.0);
+    static void    mutation(Individual&            individual,
+                            const JobShopInstance& instance);
+    static void    mutation(Individual&             individual,
+                            const CompiledInstance& instance);
     static void print_individual(const Individual& individual)
     {
         std::cout << "\n";
@@ -66,30 +228,51 @@ public:
         std::cout << '\n';
     };
 
-    void solve(const JobShopInstance& instance, Solution& global_best,
-               std::shared_mutex& gbest_mtx) override;
+    void solve(const CompiledInstance& instance, Incumbent& incumbent) override;
 
 private:
-    static Fitness get_gbest_fitnesss(const Solution&    global_best,
-                                      std::shared_mutex& gbest_mtx);
-    static Fitness get_worst_pbest_fitness(
-        const std::vector<Individual>& pbests, std::shared_mutex& pbest_mtx);
-
-    static void update_gbest(const Individual&      individual,
-                             const JobShopInstance& instance,
-                             std::shared_mutex&     gbest_mtx,
-                             Solution&              global_best);
-    static void update_pbests(const Individual&        individual,
-                              std::shared_mutex&       pbest_mtx,
-                              std::vector<Individual>& pbests);
-    void        single_thread_ga(const JobShopInstance& instance,
-                                 Solution& global_best, std::shared_mutex& gbest_mtx,
-                                 std::atomic<bool>& stop);
+    using Mailbox = SpscMailbox<Individual>;
+
+    void update_gbest(ConstChromosomeRef chromosome, Fitness fitness,
+                      const CompiledInstance& instance,
+                      Incumbent&              incumbent) const;
+    // fitness of a chromosome in the decode mode of the algorithm
+    Fitness evaluate(ConstChromosomeRef      chromosome,
+                     const CompiledInstance& instance) const
+    {
+        return decode_schedule(
+            chromosome, instance, decode_mode_, decode_delay_);
+    }
+    // evolve the persistent population of one island until stop
+    void run_island(const CompiledInstance& instance, Incumbent& incumbent,
+                    const std::atomic<bool>& stop, int island);
+    // replace the worst individuals of the ranked population with the
+    // better immigrants waiting for the island, true if any came in
+    bool receive_immigrants(PopulationArena&        population,
+                            std::span<const size_t> ranked,
+                            Individual& immigrant, int island);
+    void send_emigrants(const PopulationArena&  population,
+                        std::span<const size_t> ranked, int island);
+
+    Mailbox& mailbox(int from, int to) const
+    {
+        return *mailboxes_[static_cast<size_t>(from) * num_thread_ + to];
+    }
 
 private:
-    int                     population_size_;
-    std::shared_mutex       pbest_mtx_;
-    std::vector<Individual> pbests_;
+    size_t     population_size_;
+    Topology   topology_           = Topology::RING;
+    int        migration_interval_ = 10;
+    int        migration_size_     = 2;
+    int        generation_limit_   = 0;
+    DecodeMode decode_mode_        = DecodeMode::SEMI_ACTIVE;
+    double     decode_delay_       = 1.0;
+    // batch decode of the crossover children, picked for the instance
+    DecodeIsa decode_isa_ = DecodeIsa::SCALAR;
+    // one mailbox per ordered pair of islands, [from * islands + to], so
+    // every mailbox has a single producer and a single consumer
+    std::vector<std::unique_ptr<Mailbox>> mailboxes_;
+    std::vector<Population>               populations_;
 };
 
 }   // namespace scheduling
\ No newline at end of file
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+
+#include "compiledInstance.hpp"
+#include "types.hpp"
+
+namespace scheduling {
+
+// Batch semi-active decode: the makespans of many chromosomes of the same
+// instance at once, one chromosome per SIMD lane, all lanes stepping
+// through their genes in lockstep.
+//
+// A gene step is the same for every chromosome, only the data differs: the
+// lanes gather their operation, its machine and duration, and the machine
+// and job end times, take the max plus the duration, and scatter the end
+// times back. Per-lane state is interleaved (entity * lanes + lane), so the
+// lanes never write the same slot. The instruction set is picked at run
+// time: AVX-512 (16 lanes), AVX2 (8 lanes), or the scalar decode.
+enum class DecodeIsa
+{
+    SCALAR,
+    AVX2,
+    AVX512
+};
+
+const char* decode_isa_name(DecodeIsa isa);
+// the instruction set can be used on this cpu (and build)
+bool decode_isa_supported(DecodeIsa isa);
+// the widest supported one, picked once
+DecodeIsa decode_isa();
+// the supported one that decodes the instance fastest, timed on a few
+// batches of random chromosomes; wider is not always faster, the lanes
+// trade the scalar decode's loads for gathers and scatters
+DecodeIsa fastest_decode_isa(const CompiledInstance& instance);
+// chromosomes decoded per step with the isa
+size_t           batch_lanes(DecodeIsa isa = decode_isa());
+constexpr size_t MAX_BATCH_LANES = 16;
+
+// makespans[i] = decode_makespan(chromosomes[i], instance); every chromosome
+// holds instance.num_ops() genes. The isa must be supported.
+void decode_makespan_batch(std::span<const ConstChromosomeRef> chromosomes,
+                           const CompiledInstance&             instance,
+                           std::span<Fitness>                  makespans,
+                           DecodeIsa isa = decode_isa());
+
+}   // namespace scheduling
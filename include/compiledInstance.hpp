@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "jobShopInstance.hpp"
+#include "types.hpp"
+
+namespace scheduling {
+
+class CompiledInstance;
+
+// a fitness-only decode specialized for one instance shape
+using MakespanDecoder = Fitness (*)(ConstChromosomeRef      chromosome,
+                                    const CompiledInstance& instance);
+
+// Frozen, read-only representation of a JobShopInstance, built once and
+// shared by every algorithm and thread of a solve.
+//
+// Jobs and machines are renumbered densely (0..n-1, in the order of their
+// original ids). Operations are numbered job by job, so the steps of dense
+// job j occupy the contiguous range [job_offsets()[j], job_offsets()[j + 1]).
+// Per-operation data is stored as parallel arrays, and the operations of
+// each machine are stored in one buffer indexed by machine_offsets().
+class CompiledInstance
+{
+public:
+    CompiledInstance() = default;
+    explicit CompiledInstance(const JobShopInstance& instance);
+
+    size_t num_jobs() const { return job_ids_.size(); }
+    size_t num_machines() const { return machine_ids_.size(); }
+    size_t num_ops() const { return op_machines_.size(); }
+    // operations of every job when all jobs have as many, 0 otherwise
+    size_t ops_per_job() const { return ops_per_job_; }
+    // the specialized makespan kernel of this shape, resolved once at
+    // construction; nullptr when the shape has none
+    MakespanDecoder makespan_decoder() const { return makespan_decoder_; }
+
+    // per-operation arrays, indexed by OpID
+    std::span<const MachineID>  op_machines() const { return op_machines_; }
+    std::span<const TimePeriod> op_durations() const { return op_durations_; }
+    std::span<const JobID>      op_jobs() const { return op_jobs_; }
+    std::span<const StepID>     op_steps() const { return op_steps_; }
+
+    // per-job operation ranges, size num_jobs() + 1
+    std::span<const OpID> job_offsets() const { return job_offsets_; }
+    OpID job_begin(JobID job) const { return job_offsets_[job]; }
+    OpID job_end(JobID job) const { return job_offsets_[job + 1]; }
+
+    // per-machine operation lists, size num_machines() + 1
+    std::span<const OpID> machine_offsets() const { return machine_offsets_; }
+    std::span<const OpID> machine_ops(MachineID machine) const
+    {
+        return std::span<const OpID>(machine_op_list_)
+            .subspan(machine_offsets_[machine],
+                     machine_offsets_[machine + 1] - machine_offsets_[machine]);
+    }
+
+    // dense <-> original ids
+    std::span<const JobID>     job_ids() const { return job_ids_; }
+    std::span<const MachineID> machine_ids() const { return machine_ids_; }
+    JobID     job_index(JobID job_id) const { return job_index_[job_id]; }
+    MachineID machine_index(MachineID machine_id) const
+    {
+        return machine_index_[machine_id];
+    }
+
+    TimePeriod total_duration() const { return total_duration_; }
+    // max of the job lengths and machine loads, a makespan lower bound
+    TimeStamp lower_bound() const { return lower_bound_; }
+
+private:
+    std::vector<MachineID>  op_machines_;
+    std::vector<TimePeriod> op_durations_;
+    std::vector<JobID>      op_jobs_;
+    std::vector<StepID>     op_steps_;
+
+    std::vector<OpID> job_offsets_;
+    std::vector<OpID> machine_offsets_;
+    std::vector<OpID> machine_op_list_;
+
+    std::vector<JobID>     job_ids_;
+    std::vector<MachineID> machine_ids_;
+    std::vector<JobID>     job_index_;
+    std::vector<MachineID> machine_index_;
+
+    TimePeriod total_duration_ = 0;
+    TimeStamp  lower_bound_    = 0;
+    size_t     ops_per_job_    = 0;
+
+    MakespanDecoder makespan_decoder_ = nullptr;
+};
+
+}   // namespace scheduling
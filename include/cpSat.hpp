@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "algorithm.hpp"
+#include "compiledInstance.hpp"
+#include "incumbent.hpp"
+#include "types.hpp"
+
+#include "ortools/sat/cp_model.h"
+
+namespace scheduling {
+
+namespace sat = operations_research::sat;
+
+// CP-SAT model of the whole instance: one fixed size interval per operation
+// (indexed by OpID), job precedences, one no-overlap per machine and the
+// makespan variable. The objective and any extra constraints are left to
+// the caller.
+struct JobShopModel
+{
+    JobShopModel(const CompiledInstance& instance, int64_t horizon);
+
+    // start times of a feasible response, indexed by OpID
+    void start_times(const sat::CpSolverResponse& response,
+                     std::vector<TimeStamp>&       start_times) const;
+
+    sat::CpModelBuilder           builder;
+    std::vector<sat::IntVar>      starts;
+    std::vector<sat::IntervalVar> intervals;
+    sat::IntVar                   makespan;
+};
+
+// Exact CP-SAT backend (OR-Tools).
+//
+// Each operation is a fixed size interval, consecutive steps of a job are
+// linked by precedences and the intervals of each machine may not overlap;
+// the objective is the makespan. The incumbent schedule is passed as a
+// solution hint, improving solutions are published into the incumbent from
+// the solution callback, and the proven objective bound raises the
+// incumbent's lower bound. CP-SAT runs its own num_threads() workers, and
+// stops at the time limit or as soon as the gap is closed by anyone.
+class CpSatAlgorithm : public Algorithm
+{
+public:
+    CpSatAlgorithm(int num_threads, int time_limit)
+        : Algorithm(num_threads, time_limit){};
+
+    void solve(const CompiledInstance& instance, Incumbent& incumbent) override;
+
+    bool uses_thread_pool() const override { return false; }
+};
+
+}   // namespace scheduling
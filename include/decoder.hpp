@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "compiledInstance.hpp"
+#include "types.hpp"
+
+namespace scheduling {
+
+// Fitness-only semi-active decode: returns the makespan of the chromosome
+// without building a Solution. Uses per-thread scratch buffers, so the call
+// does not allocate once the buffers have grown to the instance size.
+//
+// The common instance shapes (machine count and operations per job, up to
+// 128 jobs) have a kernel specialized at compile time that keeps its state
+// on the stack, which decode_makespan calls through the kernel cached in the
+// instance; the other shapes use the generic decode.
+Fitness decode_makespan(ConstChromosomeRef      chromosome,
+                        const CompiledInstance& instance);
+// the same decode for any shape, without the specialized kernels
+Fitness decode_makespan_generic(ConstChromosomeRef      chromosome,
+                                const CompiledInstance& instance);
+// the shape of the instance has a specialized kernel
+bool has_fixed_shape_decoder(const CompiledInstance& instance);
+// looks up the specialized kernel of the instance shape, nullptr when there
+// is none; CompiledInstance calls it once and keeps the result
+MakespanDecoder fixed_shape_decoder(const CompiledInstance& instance);
+
+// How a chromosome is turned into a schedule. The genes are a priority
+// order of the operations, the k-th gene of a job is its k-th operation.
+//
+//     SEMI_ACTIVE       an operation starts after the operation before it
+//                       on its machine, in gene order
+//     ACTIVE            an operation goes into the earliest idle gap of its
+//                       machine that it fits in, once its job is ready
+//     GIFFLER_THOMPSON  parameterized active schedule generation: among the
+//                       operations that conflict on the machine finishing
+//                       first, the first in gene order. Only operations
+//                       starting before start + delay * (end - start) of
+//                       the earliest one conflict: delay 1 builds active
+//                       schedules, delay 0 non-delay ones
+//
+// Active schedules never have a later makespan than the semi-active one of
+// the same chromosome, and the good schedules are in the active set, so the
+// search wastes fewer evaluations on schedules with avoidable idle time.
+enum class DecodeMode
+{
+    SEMI_ACTIVE,
+    ACTIVE,
+    GIFFLER_THOMPSON
+};
+
+const char* decode_mode_name(DecodeMode mode);
+// "semi_active", "active" or "giffler_thompson", std::invalid_argument for
+// other names
+DecodeMode parse_decode_mode(std::string_view name);
+
+// makespan of the chromosome decoded with mode, and the start time of every
+// operation (indexed by OpID) when start_times is not empty
+Fitness decode_schedule(ConstChromosomeRef      chromosome,
+                        const CompiledInstance& instance, DecodeMode mode,
+                        double               delay       = 1.0,
+                        std::span<TimeStamp> start_times = {});
+
+// Semi-active decoder that re-evaluates only the changed part of a chromosome.
+//
+// reset() decodes a base chromosome and keeps a checkpoint of the machine and
+// job end times every interval() genes. evaluate() then decodes a candidate
+// that equals the base before first_changed: it resumes from the checkpoint
+// before first_changed, and stops early when the state at a checkpoint after
+// last_changed is the same as the base state (the rest of the schedule is then
+// the same as the base one), or when the makespan reaches the cutoff.
+//
+// The early stop only compares the machine and job end times, not how far
+// each job has got. So genes [first_changed, last_changed] of the candidate
+// must be a permutation of the same genes of the base, as after a swap or an
+// insert move, and first_changed <= last_changed < candidate.size().
+class IncrementalDecoder
+{
+public:
+    // interval 0: pick one from the instance size
+    explicit IncrementalDecoder(size_t interval = 0)
+        : interval_(interval)
+    {}
+
+    Fitness reset(ConstChromosomeRef base, const CompiledInstance& instance);
+
+    // makespan of the candidate, or a value >= cutoff if it reaches cutoff;
+    // the candidate has the gene multiset of the base in the changed range
+    Fitness evaluate(ConstChromosomeRef candidate, size_t first_changed,
+                     size_t  last_changed,
+                     Fitness cutoff = std::numeric_limits<Fitness>::max());
+
+    Fitness makespan() const { return makespan_; }
+    size_t  interval() const { return stride_; }
+
+private:
+    TimeStamp advance(JobID gene);
+    void      save_checkpoint(size_t checkpoint);
+    void      restore_checkpoint(size_t checkpoint);
+    bool      same_as_checkpoint(size_t checkpoint) const;
+
+    const CompiledInstance* instance_ = nullptr;
+    size_t                  interval_ = 0;
+    size_t                  stride_   = 0;
+    Fitness                 makespan_ = 0;
+
+    // checkpoint k holds the state before gene k * stride_
+    std::vector<TimeStamp> checkpoint_machine_end_;
+    std::vector<TimeStamp> checkpoint_job_end_;
+    std::vector<OpID>      checkpoint_job_next_op_;
+    std::vector<TimeStamp> checkpoint_prefix_max_;   // makespan before k
+    std::vector<TimeStamp> checkpoint_suffix_max_;   // makespan from k on
+
+    // working state
+    std::vector<TimeStamp> machine_end_;
+    std::vector<TimeStamp> job_end_;
+    std::vector<OpID>      job_next_op_;
+};
+
+}   // namespace scheduling
@@ -1,12 +1,113 @@
 #pragma once
 
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include "compiledInstance.hpp"
 #include "types.hpp"
 
 namespace scheduling {
 
+struct Solution;
+
+// Disjunctive graph of a schedule (S2), the representation used by local
+// search and tabu search.
+//
+// Nodes are the operations of the CompiledInstance. Every operation has its
+// job predecessor/successor (conjunctive arcs) and machine
+// predecessor/successor (the selected disjunctive arcs), all kept in flat
+// arrays indexed by OpID; NONE marks a missing neighbor. update() computes a
+// topological order, the heads (release times: longest path from the source
+// to the operation) and tails (longest path from the end of the operation to
+// the sink) in O(n), so makespan = max(head + duration + tail).
 class DisjunctiveGraph
 {
+public:
+    static constexpr OpID NONE = std::numeric_limits<OpID>::max();
+
+    // a maximal run of critical operations processed back to back on one
+    // machine, as positions [begin, end) of the machine sequence
+    struct CriticalBlock
+    {
+        MachineID machine;
+        size_t    begin;
+        size_t    end;
+    };
+
+    DisjunctiveGraph() = default;
+
+    // graph with the machine sequences in job order, update() not called
+    explicit DisjunctiveGraph(const CompiledInstance& instance);
+
+    // machine sequences in the order of a chromosome / of the start times of
+    // a solution or of per-operation start times, heads and tails up to date
+    static DisjunctiveGraph from_chromosome(const Chromosome&       chromosome,
+                                            const CompiledInstance& instance);
+    static DisjunctiveGraph from_solution(const Solution&         solution,
+                                          const CompiledInstance& instance);
+    static DisjunctiveGraph from_start_times(
+        std::span<const TimeStamp> start_times,
+        const CompiledInstance&    instance);
+
+    // semi-active schedule of the graph (start time = head)
+    Solution to_solution() const;
+    // job ids of the operations sorted by head, decodes back to this graph
+    Chromosome to_chromosome() const;
+
+    const CompiledInstance& instance() const { return *instance_; }
+    size_t                  num_ops() const { return job_pred_.size(); }
+
+    std::span<const OpID> machine_sequence(MachineID machine) const;
+    void set_machine_sequence(MachineID machine, std::span<const OpID> ops);
+
+    // move the operation at position from of a machine sequence to position
+    // to, shifting the operations in between (to = from + 1 is a swap)
+    void move_on_machine(MachineID machine, size_t from, size_t to);
+
+    // recompute the topological order, heads, tails and makespan, returns
+    // false if the machine sequences make the graph cyclic
+    bool update();
+
+    OpID job_pred(OpID op) const { return job_pred_[op]; }
+    OpID job_succ(OpID op) const { return job_succ_[op]; }
+    OpID machine_pred(OpID op) const { return machine_pred_[op]; }
+    OpID machine_succ(OpID op) const { return machine_succ_[op]; }
+    size_t machine_position(OpID op) const { return machine_position_[op]; }
+
+    TimeStamp  head(OpID op) const { return heads_[op]; }
+    TimeStamp  tail(OpID op) const { return tails_[op]; }
+    TimePeriod duration(OpID op) const { return instance_->op_durations()[op]; }
+    TimeStamp  makespan() const { return makespan_; }
+
+    std::span<const OpID>      topological_order() const { return topo_order_; }
+    std::span<const TimeStamp> heads() const { return heads_; }
+    std::span<const TimeStamp> tails() const { return tails_; }
+
+    // one longest path from the source to the sink, in path order
+    std::vector<OpID>          critical_path() const;
+    std::vector<CriticalBlock> critical_blocks() const;
+
+private:
+    void link_machine(MachineID machine, size_t begin, size_t end);
+
+    const CompiledInstance* instance_ = nullptr;
+
+    std::vector<OpID> job_pred_;
+    std::vector<OpID> job_succ_;
+    std::vector<OpID> machine_pred_;
+    std::vector<OpID> machine_succ_;
+
+    // machine sequences, machine m at [machine_offsets[m], ...[m + 1])
+    std::vector<OpID>   machine_sequence_;
+    std::vector<size_t> machine_position_;
 
+    std::vector<OpID>          topo_order_;
+    std::vector<unsigned char> in_degree_;   // scratch of update()
+    std::vector<TimeStamp>     heads_;
+    std::vector<TimeStamp>     tails_;
+    TimeStamp                  makespan_ = 0;
 };
 
-}   // namespace scheduling
\ No newline at end of file
+}   // namespace scheduling
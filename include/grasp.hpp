@@ -0,0 +1,90 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+
+#include "algorithm.hpp"
+#include "compiledInstance.hpp"
+#include "disjunctiveGraph.hpp"
+#include "incumbent.hpp"
+#include "random.hpp"
+#include "types.hpp"
+
+namespace scheduling {
+
+// Parallel multi-start GRASP.
+//
+// Every start builds a randomized schedule with the SolutionConstructor of
+// its worker, improves it with a descent over the N5 neighborhood, and
+// publishes improvements into the incumbent. The best distinct results are
+// kept as the elite, to seed the populations and searches of the other
+// algorithms.
+//
+// The starts run on the pool in rounds of STARTS_PER_ROUND, and each draws
+// from a random stream keyed by its index, so the elite only depends on the
+// master seed, not on which worker runs which start (unless the time limit
+// cuts the starts short).
+//
+// With reactive alpha (Prais & Ribeiro), the RCL size of each start is drawn
+// from a fixed set of alphas with probability proportional to
+// (best / average makespan of the alpha)^10, so the alphas that produce good
+// schedules on this instance are tried more often. The statistics are shared
+// by all starts, the weights are updated between rounds.
+class GraspAlgorithm : public Algorithm
+{
+public:
+    static constexpr std::array<float, 7> ALPHAS = {
+        0.0F, 0.1F, 0.2F, 0.3F, 0.5F, 0.7F, 1.0F};
+
+    // num_starts = 0 runs until the time limit
+    GraspAlgorithm(int num_threads, int time_limit, size_t num_starts = 0,
+                   size_t elite_size = 10, bool reactive_alpha = true)
+        : Algorithm(num_threads, time_limit)
+        , num_starts_(num_starts)
+        , elite_size_(elite_size)
+        , reactive_alpha_(reactive_alpha){};
+
+    void solve(const CompiledInstance& instance, Incumbent& incumbent) override;
+
+    // best distinct schedules found so far, best first
+    Population elite() const;
+
+    // descent over the N5 swaps of the critical blocks, trying the swaps in
+    // order of their estimate until one improves
+    static void local_search(DisjunctiveGraph& graph);
+
+private:
+    struct AlphaStats
+    {
+        std::atomic<std::uint64_t> makespan_sum{0};
+        std::atomic<std::uint64_t> count{0};
+    };
+
+    using AlphaWeights = std::array<double, ALPHAS.size()>;
+
+    // starts run between two updates of the alpha weights
+    static constexpr size_t STARTS_PER_ROUND = 16;
+
+    void         construct(const CompiledInstance& instance,
+                           Incumbent&              incumbent,
+                           const AlphaWeights&     weights);
+    AlphaWeights alpha_weights() const;
+    size_t pick_alpha(const AlphaWeights& weights, RandomEngine& rng) const;
+    void   add_elite(Individual individual);
+
+    size_t num_starts_;
+    size_t elite_size_;
+    bool   reactive_alpha_;
+
+    std::array<AlphaStats, ALPHAS.size()> alpha_stats_;
+    std::atomic<Fitness> best_makespan_{std::numeric_limits<Fitness>::max()};
+
+    mutable std::mutex elite_mtx_;
+    Population         elite_;
+};
+
+}   // namespace scheduling
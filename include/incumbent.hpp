@@ -0,0 +1,91 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <utility>
+
+#include "solution.hpp"
+#include "types.hpp"
+
+namespace scheduling {
+
+// Global best solution shared by all algorithms and threads, without locks.
+//
+// The best makespan is an atomic, so the "is this better?" check on the hot
+// path is one relaxed load. The best solution itself is an immutable,
+// refcounted snapshot that is swapped atomically: readers grab the current
+// snapshot and keep it alive as long as they need it, writers never wait for
+// readers. epoch() counts the published improvements, so a reader can tell
+// cheaply whether its snapshot is still the current one.
+//
+// The incumbent also keeps the best known makespan lower bound (from the
+// instance, or proven by an exact solver), so a run can stop as soon as the
+// gap is closed.
+class Incumbent
+{
+public:
+    using Snapshot = std::shared_ptr<const Solution>;
+
+    Incumbent() = default;
+    explicit Incumbent(Solution initial) { publish(std::move(initial)); }
+
+    Incumbent(const Incumbent&)            = delete;
+    Incumbent& operator=(const Incumbent&) = delete;
+    Incumbent(Incumbent&&)                 = delete;
+    Incumbent& operator=(Incumbent&&)      = delete;
+
+    Fitness makespan() const
+    {
+        return best_makespan_.load(std::memory_order_relaxed);
+    }
+    std::uint64_t epoch() const
+    {
+        return epoch_.load(std::memory_order_acquire);
+    }
+    Fitness lower_bound() const
+    {
+        return lower_bound_.load(std::memory_order_relaxed);
+    }
+    // the incumbent is proven optimal
+    bool gap_closed() const { return makespan() <= lower_bound(); }
+
+    // raise the lower bound, returns false if it is not higher
+    bool raise_lower_bound(Fitness bound);
+
+    // current best solution, null before the first publication
+    Snapshot snapshot() const;
+
+    // Publish a solution of the given makespan if it improves the incumbent.
+    // build() is only called once the improvement is claimed, and outside of
+    // any critical section, so an expensive full decode stalls nobody.
+    bool try_publish(Fitness makespan, const std::function<Solution()>& build);
+    bool publish(Solution solution);
+
+    // called with the makespan of every improvement, on the publishing
+    // thread, as soon as it is claimed; set it before the solve starts
+    void set_observer(std::function<void(Fitness)> observer)
+    {
+        observer_ = std::move(observer);
+    }
+
+private:
+    bool claim(Fitness makespan);
+    void install(const Snapshot& snapshot);
+    bool compare_exchange(Snapshot& expected, const Snapshot& desired);
+
+    std::atomic<Fitness> best_makespan_{std::numeric_limits<Fitness>::max()};
+    std::atomic<std::uint64_t>   epoch_{0};
+    std::atomic<Fitness>         lower_bound_{0};
+    std::function<void(Fitness)> observer_;
+
+#if defined(__cpp_lib_atomic_shared_ptr)
+    std::atomic<Snapshot> snapshot_;
+#else
+    Snapshot snapshot_;   // accessed through std::atomic_load/store only
+#endif
+};
+
+}   // namespace scheduling
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include "jobShopInstance.hpp"
+
+namespace scheduling {
+
+// Read-only memory mapping of a whole file (POSIX mmap), the parsers below
+// work directly on the mapped bytes.
+class MappedFile
+{
+public:
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&)            = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&&)                 = delete;
+    MappedFile& operator=(MappedFile&&)      = delete;
+
+    std::string_view view() const
+    {
+        return {static_cast<const char*>(data_), size_};
+    }
+
+private:
+    void*  data_ = nullptr;
+    size_t size_ = 0;
+};
+
+enum class InstanceFormat
+{
+    AUTO,       // JSON for .json files, else TAILLARD when the file has a
+                // "Times" section, else ORLIB
+    ORLIB,      // "n m", then per job m pairs of 0-based machine, duration
+    TAILLARD,   // header line, "n m ...", "Times" n x m, "Machines" n x m
+                // (1-based)
+    JSON        // {"jobs": [{"due_date": d, "steps": [{"machine": m,
+                //  "duration": p}, ...]}, ...]}, a job's optional "id" is
+                // its position otherwise; the job and machine ids are dense
+                // from 0, and a job visits a machine at most once
+};
+
+// Replace the instance with the one of the file. Malformed input throws
+// std::runtime_error naming the file and the problem.
+void load_instance(const std::string& path, JobShopInstance& instance,
+                   InstanceFormat format = InstanceFormat::AUTO);
+
+// the parsers, on the whole text of a file; numbers are read in place with
+// std::from_chars, nothing is copied
+void parse_orlib(std::string_view text, JobShopInstance& instance);
+void parse_taillard(std::string_view text, JobShopInstance& instance);
+void parse_json(std::string_view text, JobShopInstance& instance);
+
+}   // namespace scheduling
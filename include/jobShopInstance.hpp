@@ -48,9 +48,15 @@ public:
     JobShopInstance(JobShopInstance&&)            = delete;
     JobShopInstance& operator=(JobShopInstance&&) = delete;
 
-    std::map<JobID, Job>         jobs() const { return jobs_; }
-    std::map<MachineID, Machine> machines() const { return machines_; }
+    // zero-copy read access, solvers should use a CompiledInstance instead
+    const std::map<JobID, Job>&         jobs() const { return jobs_; }
+    const std::map<MachineID, Machine>& machines() const { return machines_; }
 
+    void clear()
+    {
+        jobs_.clear();
+        machines_.clear();
+    }
     void add_job(JobID job_id, TimeStamp due_date)
     {
         jobs_[job_id] = Job{job_id, due_date};
@@ -66,9 +72,6 @@ public:
             Step{job_id, step_id, machine_id, duration};
     }
 
-    std::map<JobID, Job>         jobs() { return jobs_; }
-    std::map<MachineID, Machine> machines() { return machines_; }
-
     void generate_instance(int num_job, int num_machine);
     void print() const;
 
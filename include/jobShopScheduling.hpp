@@ -1,10 +1,10 @@
 #pragma once
 
 #include <memory>
-#include <shared_mutex>
 #include <vector>
 
 #include "algorithm.hpp"
+#include "incumbent.hpp"
 #include "jobShopInstance.hpp"
 
 namespace scheduling {
@@ -22,7 +22,7 @@ public:
 
     void add_algorithm(Algorithm algorithm, int num_thread, int time_limit);
     void
-    solve();   // pass instance, gbest_mtx_, gbest_solution_ to each algorithm
+    solve();   // pass instance, incumbent_ to each algorithm
     Solution gbest_solution() const;
 
 private:
@@ -30,8 +30,7 @@ private:
     int                                     total_threads_;
     int                                     time_limit_;
     std::vector<std::unique_ptr<Algorithm>> algorithms_;
-    std::shared_mutex                       gbest_mtx_;
-    Solution                                gbest_solution_;
+    Incumbent                               incumbent_;
 };
 
 }   // namespace scheduling
\ No newline at end of file
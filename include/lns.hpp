@@ -0,0 +1,69 @@
+#pragma once
+
+#include <atomic>
+#include <vector>
+
+#include "algorithm.hpp"
+#include "compiledInstance.hpp"
+#include "disjunctiveGraph.hpp"
+#include "incumbent.hpp"
+#include "types.hpp"
+
+namespace scheduling {
+
+// Large neighborhood search on the machine sequences (S1).
+//
+// Each iteration relaxes part of the current schedule: the operations that
+// start in a time window, the operations of a subset of machines, or the
+// operations of a random set of jobs. The relaxed operations are rescheduled
+// either by a time-capped, single-worker CP-SAT subproblem over the relaxed
+// operations only, around the fixed start times of the others, or by a
+// Giffler & Thompson dispatching rule that keeps the machine order of the
+// others. Every worker solves its own subproblems as a job of the shared
+// pool, improvements are published into the incumbent, and a worker jumps
+// to the incumbent when another one found a better schedule. The relaxed
+// fraction adapts: it grows while CP-SAT proves its subproblems optimal,
+// and shrinks when they time out.
+class LnsAlgorithm : public Algorithm
+{
+public:
+    enum class Relaxation
+    {
+        TIME_WINDOW,
+        MACHINES,
+        JOBS
+    };
+
+    LnsAlgorithm(int num_threads, int time_limit,
+                 double subproblem_time_limit = 1.0)
+        : Algorithm(num_threads, time_limit)
+        , subproblem_time_limit_(subproblem_time_limit){};
+
+    void solve(const CompiledInstance& instance, Incumbent& incumbent) override;
+
+    // mark the operations to reschedule, about fraction of them
+    static void relax(const DisjunctiveGraph& graph, Relaxation relaxation,
+                      double fraction, std::vector<char>& relaxed);
+
+    // reschedule the relaxed operations with the Giffler & Thompson rule
+    // (most work remaining first), the others keep their machine order
+    static DisjunctiveGraph repair_with_dispatching(
+        const DisjunctiveGraph& graph, const std::vector<char>& relaxed);
+
+private:
+    // reschedule the relaxed operations with CP-SAT in the machine windows
+    // left by the fixed operations, then left shift the schedule; returns
+    // false when no schedule is found in time, sets optimal when the
+    // subproblem is solved
+    bool repair_with_cp_sat(const DisjunctiveGraph&  graph,
+                            const std::vector<char>& relaxed,
+                            std::atomic<bool>& stop, DisjunctiveGraph& repaired,
+                            bool& optimal) const;
+
+    void search(const CompiledInstance& instance, Incumbent& incumbent,
+                std::atomic<bool>& stop, int worker) const;
+
+    double subproblem_time_limit_;
+};
+
+}   // namespace scheduling
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace scheduling {
+
+// Bounded lock-free single-producer/single-consumer queue.
+//
+// One thread pushes, one (other) thread pops, neither ever waits: a push
+// into a full mailbox is dropped, a pop from an empty one returns false.
+// The ring has one slot more than the capacity, so head == tail means
+// empty; the producer owns head_, the consumer owns tail_, each on its own
+// cache line.
+template<typename T> class SpscMailbox
+{
+public:
+    explicit SpscMailbox(size_t capacity)
+        : slots_(capacity + 1)
+    {}
+
+    SpscMailbox(const SpscMailbox&)            = delete;
+    SpscMailbox& operator=(const SpscMailbox&) = delete;
+    SpscMailbox(SpscMailbox&&)                 = delete;
+    SpscMailbox& operator=(SpscMailbox&&)      = delete;
+
+    size_t capacity() const { return slots_.size() - 1; }
+
+    // producer side, false (and the item is dropped) when full
+    bool try_push(T item)
+    {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        const size_t next = head + 1 == slots_.size() ? 0 : head + 1;
+        if (next == tail_.load(std::memory_order_acquire)) {
+            return false;
+        }
+        slots_[head] = std::move(item);
+        head_.store(next, std::memory_order_release);
+        return true;
+    }
+
+    // consumer side, false when empty
+    bool try_pop(T& item)
+    {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail == head_.load(std::memory_order_acquire)) {
+            return false;
+        }
+        item = std::move(slots_[tail]);
+        tail_.store(tail + 1 == slots_.size() ? 0 : tail + 1,
+                    std::memory_order_release);
+        return true;
+    }
+
+private:
+    std::vector<T>                  slots_;
+    alignas(64) std::atomic<size_t> head_{0};   // next slot to write
+    alignas(64) std::atomic<size_t> tail_{0};   // next slot to read
+};
+
+}   // namespace scheduling
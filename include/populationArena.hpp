@@ -0,0 +1,69 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "types.hpp"
+
+namespace scheduling {
+
+// Population stored as one contiguous chromosome matrix, one row of genes
+// per individual, next to their fitness.
+//
+// The GA keeps a parent and a child arena and swaps them every generation:
+// selection picks rows, and the operators write the children into their
+// rows in place, so a generation allocates nothing once both arenas are
+// sized, and an individual is a cache-friendly slice instead of a vector.
+class PopulationArena
+{
+public:
+    PopulationArena() = default;
+    PopulationArena(size_t capacity, size_t chromosome_size)
+        : genes_(capacity * chromosome_size)
+        , fitness_(capacity, 0)
+        , chromosome_size_(chromosome_size)
+    {}
+
+    size_t capacity() const { return fitness_.size(); }
+    size_t chromosome_size() const { return chromosome_size_; }
+
+    ChromosomeRef chromosome(size_t row)
+    {
+        return {genes_.data() + row * chromosome_size_, chromosome_size_};
+    }
+    ConstChromosomeRef chromosome(size_t row) const
+    {
+        return {genes_.data() + row * chromosome_size_, chromosome_size_};
+    }
+
+    Fitness& fitness(size_t row) { return fitness_[row]; }
+    Fitness  fitness(size_t row) const { return fitness_[row]; }
+
+    void assign(size_t row, const Individual& individual)
+    {
+        std::ranges::copy(individual.chromosome, chromosome(row).begin());
+        fitness_[row] = individual.fitness;
+    }
+
+    // copy a row of another arena (of the same chromosome size)
+    void copy(size_t row, const PopulationArena& from, size_t from_row)
+    {
+        std::ranges::copy(from.chromosome(from_row), chromosome(row).begin());
+        fitness_[row] = from.fitness_[from_row];
+    }
+
+    Individual individual(size_t row) const
+    {
+        const ConstChromosomeRef genes = chromosome(row);
+        return {Chromosome(genes.begin(), genes.end()), fitness_[row]};
+    }
+
+private:
+    std::vector<unsigned int> genes_;
+    std::vector<Fitness>      fitness_;
+    size_t                    chromosome_size_ = 0;
+};
+
+}   // namespace scheduling
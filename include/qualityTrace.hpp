@@ -0,0 +1,57 @@
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "types.hpp"
+
+namespace scheduling {
+
+// Incumbent makespan over time of one solve, and the anytime quality
+// measures computed from it.
+//
+// record() is meant as the incumbent observer: it is called from the
+// publishing threads, on improvements only, so a mutex is cheap enough.
+class QualityTrace
+{
+public:
+    struct Point
+    {
+        double  seconds;   // since start()
+        Fitness makespan;
+    };
+
+    // restart the clock and drop the points
+    void start();
+    void record(Fitness makespan);
+    double elapsed() const;
+
+    std::vector<Point> points() const;
+
+    // Primal integral (Berthold) over [0, horizon] seconds: the integral of
+    // the primal gap (z - reference) / max(z, reference) of the incumbent
+    // z, which is 1 before the first solution. Smaller is better, a run that
+    // has the reference at time 0 scores 0.
+    static double primal_integral(std::span<const Point> points,
+                                  Fitness reference, double horizon);
+
+    // seconds until the incumbent reached the target, none if it never did
+    static std::optional<double> time_to_target(std::span<const Point> points,
+                                                Fitness target);
+
+    // best makespan of the trace, none if empty
+    static std::optional<Fitness> final_makespan(
+        std::span<const Point> points);
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    Clock::time_point  start_ = Clock::now();
+    mutable std::mutex mutex_;
+    std::vector<Point> points_;
+};
+
+}   // namespace scheduling
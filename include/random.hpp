@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+namespace scheduling {
+
+// xoshiro256** generator (Blackman & Vigna), a UniformRandomBitGenerator with
+// 32 bytes of state, seeded through splitmix64.
+class RandomEngine
+{
+public:
+    using result_type = std::uint64_t;
+
+    explicit RandomEngine(std::uint64_t seed = 0) { this->seed(seed); }
+
+    void seed(std::uint64_t seed)
+    {
+        for (auto& word : state_) {
+            seed += 0x9E3779B97F4A7C15ULL;
+            word = splitmix64(seed);
+        }
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max()
+    {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    result_type operator()()
+    {
+        const std::uint64_t result = rotl(state_[1] * 5, 7) * 9;
+        const std::uint64_t temp   = state_[1] << 17;
+
+        state_[2] ^= state_[0];
+        state_[3] ^= state_[1];
+        state_[1] ^= state_[2];
+        state_[0] ^= state_[3];
+        state_[2] ^= temp;
+        state_[3] = rotl(state_[3], 45);
+
+        return result;
+    }
+
+    static std::uint64_t splitmix64(std::uint64_t value)
+    {
+        value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+        return value ^ (value >> 31);
+    }
+
+private:
+    static std::uint64_t rotl(std::uint64_t value, int shift)
+    {
+        return (value << shift) | (value >> (64 - shift));
+    }
+
+    std::uint64_t state_[4]{};
+};
+
+// One master seed drives the whole solve. Every thread owns an engine whose
+// seed is derived from the master seed and the thread's stream id, so runs
+// are reproducible when each worker thread picks a fixed stream.
+//
+// Setting the master seed reseeds the engines of all threads lazily, on their
+// next thread_rng() call.
+void          set_master_seed(std::uint64_t seed);
+std::uint64_t master_seed();
+
+// reseed the calling thread's engine with the given stream id, threads that
+// never call it get stream ids in the order of their first thread_rng() call
+void set_thread_stream(std::uint64_t stream);
+
+RandomEngine& thread_rng();
+
+// stream id of the index-th task spawned by the given stream
+std::uint64_t task_stream(std::uint64_t stream, std::uint64_t index);
+
+// Reseeds the calling thread's engine with the given stream id for its scope,
+// and restores the previous engine and its state at the end of it, so a task
+// of the pool draws the same numbers whichever worker runs it.
+class ScopedThreadStream
+{
+public:
+    explicit ScopedThreadStream(std::uint64_t stream);
+    ~ScopedThreadStream();
+
+    ScopedThreadStream(const ScopedThreadStream&)            = delete;
+    ScopedThreadStream& operator=(const ScopedThreadStream&) = delete;
+
+private:
+    RandomEngine  engine_;
+    std::uint64_t stream_;
+    std::uint64_t epoch_;
+};
+
+}   // namespace scheduling
@@ -1,14 +1,29 @@
 #pragma once
 
+#include "affinity.hpp"
 #include "algorithm.hpp"
+#include "compiledInstance.hpp"
+#include "cpSat.hpp"
+#include "decoder.hpp"
+#include "disjunctiveGraph.hpp"
+#include "grasp.hpp"
+#include "incumbent.hpp"
 #include "jobShopInstance.hpp"
+#include "lns.hpp"
 #include "solution.hpp"
 #include "solutionConstructor.hpp"
+#include "tabuSearch.hpp"
+#include "telemetry.hpp"
+#include "threadPool.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
 #include <memory>
-#include <mutex>
-#include <shared_mutex>
+#include <numeric>
+#include <ostream>
 #include <thread>
+#include <utility>
 #include <vector>
 
 namespace scheduling {
@@ -18,54 +33,238 @@ class Run
 public:
     Run(const JobShopInstance& instance, int num_threads, int time_limit)
         : instance_(instance)
+        , compiled_instance_(std::make_shared<const CompiledInstance>(instance))
         , num_threads_(num_threads)
         , time_limit_(time_limit)
     {
-        SolutionConstructor constructor;
-        constructor.convert_from_instance(instance);
-        gbest_ = constructor.schedule();
-        std::cout << "Initial gbest fitness: " << gbest_.makespan << "\n";
+        incumbent_.raise_lower_bound(compiled_instance_->lower_bound());
     };
 
+    // seed the incumbent and all registered algorithms (the GA, tabu search,
+    // CP-SAT and LNS when none is registered) with a multi-start GRASP, then
+    // run the algorithms at the same time, each on its share of the thread
+    // budget, for the rest of the time limit or until the incumbent is
+    // proven optimal
     void operator()()
     {
         // global_best_.print();
-        add_ga_algorithm(num_threads_);
-        for (const auto& algorithm : algorithms_) {
-            algorithm->solve(instance_, gbest_, gbest_mtx_);
+        std::unique_ptr<TelemetryReporter> reporter;
+        if (telemetry_out_ != nullptr) {
+            reporter = std::make_unique<TelemetryReporter>(
+                *telemetry_out_, telemetry_interval_, incumbent_);
         }
-        std::cout << "Final gbest fitness: " << gbest_.makespan << "\n";
+        if (algorithms_.empty()) {
+            add_ga_algorithm(num_threads_);
+            add_tabu_search_algorithm(num_threads_);
+            add_cp_sat_algorithm(num_threads_);
+            add_lns_algorithm(num_threads_);
+        }
+        allocate_threads();
+        seed_algorithms();
+
+        // the runners only wait for their algorithm: the workers run on the
+        // pool, or on CP-SAT's own threads
+        std::vector<std::thread> runners;
+        runners.reserve(algorithms_.size());
+        for (size_t i = 0; i < algorithms_.size(); i++) {
+            algorithms_[i]->set_random_stream(i + 1);
+            runners.emplace_back([this, &algorithm = *algorithms_[i]]() {
+                algorithm.solve(*compiled_instance_, incumbent_);
+            });
+        }
+        for (auto& runner : runners) {
+            runner.join();
+        }
+        reporter.reset();
+        std::cout << "Final gbest fitness: " << incumbent_.makespan()
+                  << ", lower bound: " << incumbent_.lower_bound() << "\n";
+        pool_->print_stats();
     }
 
+    // split the thread budget evenly over the algorithms (at least one thread
+    // each), and create the task pool from the slices of the algorithms
+    // that run on it: one worker per slice thread for their long-running
+    // jobs, plus helper workers for the fine-grained tasks the jobs submit,
+    // one per cpu left over by the slices and at least one. The pool is the
+    // only source of worker threads besides CP-SAT's own. With cpu affinity
+    // each slice gets its own range of cpus, the pool workers are pinned to
+    // the cpus of its slices and to the cpus left over
     void allocate_threads()
     {
-        int num_thread = num_threads_ / algorithms_.size();
-        for (int i = 0; i < algorithms_.size(); i++) {
+        algorithm_threads_.clear();
+        const int num_algorithms = static_cast<int>(algorithms_.size());
+        const std::vector<int> cpus = available_cpus();
+
+        int              pool_threads = 0;
+        std::vector<int> pool_cpus;
+        size_t           next_cpu = 0;
+        for (int i = 0; i < num_algorithms; i++) {
+            int num_thread = num_threads_ / num_algorithms +
+                             (i < num_threads_ % num_algorithms ? 1 : 0);
+            num_thread = std::max(1, num_thread);
             algorithm_threads_.push_back(num_thread);
+            algorithms_[i]->set_num_threads(num_thread);
+
+            std::vector<int> cpu_set;
+            if (cpu_affinity_) {
+                for (int j = 0; j < num_thread; j++) {
+                    cpu_set.push_back(cpus[next_cpu++ % cpus.size()]);
+                }
+            }
+            if (algorithms_[i]->uses_thread_pool()) {
+                pool_threads += num_thread;
+                pool_cpus.insert(pool_cpus.end(), cpu_set.begin(),
+                                 cpu_set.end());
+            }
+            else {
+                algorithms_[i]->set_cpu_set(std::move(cpu_set));
+            }
+        }
+
+        // the jobs keep one worker each for the whole solve, the helpers
+        // are idle until a job spreads its work with parallel_for
+        const int num_used       = std::accumulate(algorithm_threads_.begin(),
+                                                   algorithm_threads_.end(), 0);
+        const int helper_threads =
+            std::max(1, static_cast<int>(cpus.size()) - num_used);
+        for (int j = 0; cpu_affinity_ && j < helper_threads; j++) {
+            pool_cpus.push_back(cpus[next_cpu++ % cpus.size()]);
+        }
+
+        pool_ = std::make_unique<ThreadPool>(pool_threads + helper_threads,
+                                             std::move(pool_cpus));
+        for (auto& algorithm : algorithms_) {
+            algorithm->set_thread_pool(pool_.get());
+        }
+    }
+
+    // GRASP on all workers of the task pool for grasp_starts_ starts, and at
+    // most GRASP_SHARE of the time limit; its elite seeds every registered
+    // algorithm, which get the rest of the time limit
+    void seed_algorithms()
+    {
+        using std::chrono::milliseconds;
+        const milliseconds time_limit = std::chrono::seconds(time_limit_);
+        const auto         start      = std::chrono::steady_clock::now();
+
+        GraspAlgorithm grasp(pool_->num_workers(), time_limit_,
+                             grasp_starts_, elite_size_);
+        grasp.set_time_limit(
+            std::chrono::duration_cast<milliseconds>(time_limit * GRASP_SHARE));
+        grasp.set_thread_pool(pool_.get());
+        grasp.solve(*compiled_instance_, incumbent_);
+
+        const milliseconds remaining =
+            time_limit - std::chrono::duration_cast<milliseconds>(
+                             std::chrono::steady_clock::now() - start);
+        Population seeds = grasp.elite();
+        if (!warm_start_.chromosome.empty()) {
+            seeds.insert(seeds.begin(), warm_start_);
+        }
+        for (auto& algorithm : algorithms_) {
+            algorithm->set_seeds(seeds);
+            algorithm->set_time_limit(std::max(remaining, milliseconds(0)));
+        }
+        std::cout << "Initial gbest fitness: " << incumbent_.makespan()
+                  << ", lower bound: " << incumbent_.lower_bound()
+                  << ", seeds: " << seeds.size() << "\n";
+    }
+
+    // start from a known schedule of the instance (e.g. the incumbent of a
+    // previous run): it is published into the incumbent and seeds the
+    // algorithms first
+    void warm_start(Solution solution)
+    {
+        if (solution.chromo.empty()) {
+            solution.chromo =
+                DisjunctiveGraph::from_solution(solution, *compiled_instance_)
+                    .to_chromosome();
         }
+        warm_start_ = Individual{solution.chromo, solution.makespan};
+        incumbent_.publish(std::move(solution));
+    }
+
+    Incumbent::Snapshot best() const { return incumbent_.snapshot(); }
+    Incumbent&          incumbent() { return incumbent_; }
+
+    // number of GRASP starts and size of the elite that seeds the algorithms
+    void set_grasp_starts(size_t grasp_starts) { grasp_starts_ = grasp_starts; }
+    void set_elite_size(size_t elite_size) { elite_size_ = elite_size; }
+
+    // write a JSON line of telemetry to out every interval during the run,
+    // null to disable
+    void set_telemetry(std::ostream* out, std::chrono::milliseconds interval)
+    {
+        telemetry_out_      = out;
+        telemetry_interval_ = interval;
+    }
+
+    // pin the pool workers and CP-SAT's threads to their own cpus
+    void set_cpu_affinity(bool cpu_affinity) { cpu_affinity_ = cpu_affinity; }
+
+    // decode mode of the GA chromosomes, set before adding the GA
+    void set_decode_mode(DecodeMode mode, double delay = 1.0)
+    {
+        decode_mode_  = mode;
+        decode_delay_ = delay;
     }
 
     void add_ga_algorithm(int num_threads)
     {
         auto genatic_algorithm =
             std::make_unique<GAAlgorithm>(num_threads, time_limit_, 100);
+        genatic_algorithm->set_decode_mode(decode_mode_, decode_delay_);
         algorithms_.push_back(std::move(genatic_algorithm));
     };
 
+    void add_tabu_search_algorithm(int num_threads)
+    {
+        auto tabu_search =
+            std::make_unique<TabuSearchAlgorithm>(num_threads, time_limit_);
+        algorithms_.push_back(std::move(tabu_search));
+    };
+
+    void add_cp_sat_algorithm(int num_threads)
+    {
+        auto cp_sat =
+            std::make_unique<CpSatAlgorithm>(num_threads, time_limit_);
+        algorithms_.push_back(std::move(cp_sat));
+    };
+
+    void add_lns_algorithm(int num_threads)
+    {
+        auto lns = std::make_unique<LnsAlgorithm>(num_threads, time_limit_);
+        algorithms_.push_back(std::move(lns));
+    };
+
     void print_gbest()
     {
-        std::shared_lock<std::shared_mutex> lock(gbest_mtx_);
-        gbest_.print();
+        if (auto gbest = incumbent_.snapshot()) {
+            gbest->print();
+        }
     };
 
 private:
+    // largest share of the time limit spent seeding with GRASP
+    static constexpr double GRASP_SHARE = 0.1;
+
     JobShopInstance                         instance_;
-    Solution                                gbest_;
-    std::shared_mutex                       gbest_mtx_;
+    std::shared_ptr<const CompiledInstance> compiled_instance_;
+    Incumbent                               incumbent_;
     std::vector<std::unique_ptr<Algorithm>> algorithms_;
     std::vector<int>                        algorithm_threads_;
+    std::unique_ptr<ThreadPool>             pool_;
     int                                     num_threads_;
     int                                     time_limit_;
+    bool                                    cpu_affinity_ = false;
+    size_t                                  grasp_starts_ = 100;
+    size_t                                  elite_size_   = 10;
+    Individual                              warm_start_{};
+    DecodeMode                              decode_mode_ =
+        DecodeMode::SEMI_ACTIVE;
+    double                                  decode_delay_ = 1.0;
+    std::ostream*                           telemetry_out_ = nullptr;
+    std::chrono::milliseconds               telemetry_interval_{1000};
 };
 
 }   // namespace scheduling
\ No newline at end of file
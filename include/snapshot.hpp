@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+
+#include "compiledInstance.hpp"
+#include "instanceLoader.hpp"
+#include "jobShopInstance.hpp"
+#include "solution.hpp"
+#include "types.hpp"
+
+namespace scheduling {
+
+// Versioned binary snapshot of an instance, and optionally of a schedule and
+// its chromosome, to save and restore the state of a run.
+//
+// All values are fixed-width little-endian. A 64 byte header is followed by
+// the arrays below, each one starting on an 8 byte boundary; their sizes
+// follow from the header counts. The instance arrays are laid out like the
+// CompiledInstance (dense job and machine indices, operations job by job):
+//
+//     job_ids        u32[num_jobs]       original job ids
+//     due_dates      u32[num_jobs]
+//     job_offsets    u32[num_jobs + 1]   operation range of each job
+//     machine_ids    u32[num_machines]   original machine ids
+//     op_machines    u32[num_ops]        dense machine index
+//     op_durations   u32[num_ops]
+//     op_steps       u32[num_ops]        original step ids
+//     start_times    u32[num_ops]        with a schedule
+//     chromosome     u32[chromosome_size]
+class SnapshotFile
+{
+public:
+    static constexpr char          MAGIC[8]    = {'J', 'S', 'S', 'S',
+                                                  'N', 'A', 'P', '\0'};
+    static constexpr std::uint32_t VERSION     = 1;
+    static constexpr size_t        HEADER_SIZE = 64;
+
+    // map and validate a snapshot, malformed files throw std::runtime_error;
+    // the arrays are used in place, which needs a little-endian host
+    explicit SnapshotFile(const std::string& path);
+
+    size_t num_jobs() const { return num_jobs_; }
+    size_t num_machines() const { return num_machines_; }
+    size_t num_ops() const { return num_ops_; }
+
+    std::span<const JobID>      job_ids() const { return job_ids_; }
+    std::span<const TimeStamp>  due_dates() const { return due_dates_; }
+    std::span<const OpID>       job_offsets() const { return job_offsets_; }
+    std::span<const MachineID>  machine_ids() const { return machine_ids_; }
+    std::span<const MachineID>  op_machines() const { return op_machines_; }
+    std::span<const TimePeriod> op_durations() const { return op_durations_; }
+    std::span<const StepID>     op_steps() const { return op_steps_; }
+
+    bool has_solution() const { return !start_times_.empty(); }
+    Fitness makespan() const { return makespan_; }
+    // indexed by OpID, empty without a schedule
+    std::span<const TimeStamp> start_times() const { return start_times_; }
+    std::span<const unsigned int> chromosome() const { return chromosome_; }
+
+    // replace the instance with the one of the snapshot
+    void to_instance(JobShopInstance& instance) const;
+    // the schedule, on the compiled instance of to_instance()
+    Solution to_solution(const CompiledInstance& instance) const;
+
+private:
+    MappedFile file_;
+    size_t     num_jobs_     = 0;
+    size_t     num_machines_ = 0;
+    size_t     num_ops_      = 0;
+    Fitness    makespan_     = 0;
+
+    std::span<const JobID>        job_ids_;
+    std::span<const TimeStamp>    due_dates_;
+    std::span<const OpID>         job_offsets_;
+    std::span<const MachineID>    machine_ids_;
+    std::span<const MachineID>    op_machines_;
+    std::span<const TimePeriod>   op_durations_;
+    std::span<const StepID>       op_steps_;
+    std::span<const TimeStamp>    start_times_;
+    std::span<const unsigned int> chromosome_;
+};
+
+// Write the instance, and the schedule when given (its chromosome, or one
+// derived from its start times), to path. The file is written next to path
+// and renamed over it, so a reader never sees a partial snapshot.
+void save_snapshot(const std::string& path, const JobShopInstance& instance,
+                   const Solution* solution = nullptr);
+
+}   // namespace scheduling
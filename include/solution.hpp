@@ -1,11 +1,12 @@
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
 #include <iostream>
-#include <limits>
-#include <map>
-#include <memory>
+#include <span>
 #include <vector>
 
+#include "compiledInstance.hpp"
 #include "disjunctiveGraph.hpp"
 #include "jobShopInstance.hpp"
 #include "types.hpp"
@@ -14,96 +15,110 @@
 namespace scheduling {
 
 
-struct Task
+// A preventive maintenance slot on a machine (to be added later in the
+// project)
+struct PMTask
 {
-    MachineID  machine_id;
-    TimePeriod duration;
-    TimeStamp  start_time = 0;
-    TimeStamp  end_time   = std::numeric_limits<TimeStamp>::max();
-
-    Task(MachineID machine_id, TimePeriod duration, TimeStamp start_time,
-         TimeStamp end_time)
-        : machine_id(machine_id)
-        , duration(duration)
-        , start_time(start_time)
-        , end_time(end_time)
-    {}
-
-    virtual ~Task() = default;
+    int       pm_id      = 0;
+    MachineID machine_id = 0;
+    TimeStamp start_time = 0;
+    TimeStamp end_time   = 0;
 };
 
-struct StepTask : public Task
-{
-    JobID    job_id;
-    StepID   step_id;
-    TaskType task_type = TaskType::STEP;
-
-    StepTask(MachineID machine_id, TimePeriod duration, TimeStamp start_time,
-             TimeStamp end_time, JobID job_id, StepID step_id)
-        : Task{machine_id, duration, start_time, end_time}
-        , job_id(job_id)
-        , step_id(step_id)
-    {}
-};
-
-struct PMTask : public Task
+// A schedule, stored flat so that copying it is a handful of memcpy calls.
+//
+// Operations are numbered like the CompiledInstance the schedule was built
+// on (OpID, job by job), machines by their dense index. The per-operation
+// arrays hold the times and the original job and step ids; the operations
+// of machine m are, in processing order,
+// machine_sequences[machine_offsets[m] .. machine_offsets[m + 1]).
+struct Solution
 {
-    int      pm_id;
-    TaskType task_type = TaskType::PM;
+    // per operation, indexed by OpID
+    std::vector<TimeStamp> start_times;
+    std::vector<TimeStamp> end_times;
+    std::vector<JobID>     job_ids;
+    std::vector<StepID>    step_ids;
+
+    // per machine, indexed by dense machine index
+    std::vector<MachineID> machine_ids;
+    std::vector<OpID>      machine_offsets;
+    std::vector<OpID>      machine_sequences;
+
+    std::vector<PMTask> pm_tasks;
+    DisjunctiveGraph    graph;
+    Chromosome          chromo;
+    Fitness             makespan = 0;
+
+    Solution() = default;
+
+    // sized for the instance, all operations at time 0 and the machine
+    // sequences in job order
+    explicit Solution(const CompiledInstance& instance)
+        : start_times(instance.num_ops(), 0)
+        , end_times(instance.num_ops(), 0)
+        , job_ids(instance.num_ops())
+        , step_ids(instance.op_steps().begin(), instance.op_steps().end())
+        , machine_ids(instance.machine_ids().begin(),
+                      instance.machine_ids().end())
+        , machine_offsets(instance.machine_offsets().begin(),
+                          instance.machine_offsets().end())
+        , machine_sequences(instance.num_ops())
+    {
+        for (OpID op = 0; op < instance.num_ops(); ++op) {
+            job_ids[op] = instance.job_ids()[instance.op_jobs()[op]];
+        }
+        for (MachineID machine = 0; machine < instance.num_machines();
+             ++machine) {
+            std::ranges::copy(instance.machine_ops(machine),
+                              machine_sequences.begin() +
+                                  machine_offsets[machine]);
+        }
+    }
 
-    // to be added later in the project
-};
+    size_t num_ops() const { return start_times.size(); }
+    size_t num_machines() const { return machine_ids.size(); }
+    bool   empty() const { return start_times.empty(); }
 
-struct Solution
-{
-    std::map<TaskID, std::shared_ptr<StepTask>>           step_tasks;
-    std::map<TaskID, std::shared_ptr<PMTask>>             pm_tasks;
-    std::map<MachineID, std::vector<std::weak_ptr<Task>>> schedules;
-    DisjunctiveGraph                                      graph;
-    Chromosome                                            chromo;
-    Fitness                                               makespan = 0;
+    std::span<const OpID> machine_sequence(MachineID machine) const
+    {
+        return std::span<const OpID>(machine_sequences)
+            .subspan(machine_offsets[machine],
+                     machine_offsets[machine + 1] - machine_offsets[machine]);
+    }
+    std::span<OpID> machine_sequence(MachineID machine)
+    {
+        return std::span<OpID>(machine_sequences)
+            .subspan(machine_offsets[machine],
+                     machine_offsets[machine + 1] - machine_offsets[machine]);
+    }
 
     void update_makespan()
     {
         makespan = 0;
-        for (const auto& [machine_id, tasks] : schedules) {
-            for (const auto& task : tasks) {
-                auto locked_task = task.lock();
-                if (auto step_task =
-                        std::dynamic_pointer_cast<StepTask>(locked_task)) {
-                    if (step_task->end_time > makespan) {
-                        makespan = step_task->end_time;
-                    }
-                }
-                else if (auto pm_task =
-                             std::dynamic_pointer_cast<PMTask>(locked_task)) {
-                    if (pm_task->end_time > makespan) {
-                        makespan = pm_task->end_time;
-                    }
-                }
-            }
+        for (TimeStamp end_time : end_times) {
+            makespan = std::max(makespan, end_time);
+        }
+        for (const PMTask& pm_task : pm_tasks) {
+            makespan = std::max(makespan, pm_task.end_time);
         }
     };
 
-    void print()
+    void print() const
     {
         std::cout << "Solution: \n";
-        for (const auto& [machine_id, tasks] : schedules) {
-            std::cout << "Machine " << machine_id << ": ";
-            for (const auto& task : tasks) {
-                auto locked_task = task.lock();
-                if (auto step_task =
-                        std::dynamic_pointer_cast<StepTask>(locked_task)) {
-                    std::cout << "Job :" << step_task->job_id
-                              << " Step: " << step_task->step_id
-                              << " Start: " << step_task->start_time << " "
-                              << "End: " << step_task->end_time << " \n ";
-                }
-                else if (auto pm_task =
-                             std::dynamic_pointer_cast<PMTask>(locked_task)) {
-                    std::cout << "PM :" << pm_task->pm_id
-                              << " Start: " << pm_task->start_time << " "
-                              << "End: " << pm_task->end_time << " \n ";
+        for (MachineID machine = 0; machine < num_machines(); ++machine) {
+            std::cout << "Machine " << machine_ids[machine] << ": ";
+            for (OpID op : machine_sequence(machine)) {
+                std::cout << "Job :" << job_ids[op] << " Step: " << step_ids[op]
+                          << " Start: " << start_times[op] << " "
+                          << "End: " << end_times[op] << " \n ";
+            }
+            for (const PMTask& pm_task : pm_tasks) {
+                if (pm_task.machine_id == machine_ids[machine]) {
+                    std::cout << "PM :" << pm_task.pm_id
+                              << " Start: " << pm_task.start_time << " "
+                              << "End: " << pm_task.end_time << " \n ";
                 }
             }
             std::cout << "\n";
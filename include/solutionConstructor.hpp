@@ -1,11 +1,13 @@
 #pragma once
 
+#include "compiledInstance.hpp"
 #include "jobShopInstance.hpp"
+#include "random.hpp"
 #include "solution.hpp"
 #include "types.hpp"
 #include <algorithm>
 #include <cstddef>
-#include <map>
+#include <cstdint>
 #include <memory>
 #include <random>
 #include <vector>
@@ -13,168 +15,164 @@
 
 namespace scheduling {
 
+// Randomized (GRASP) list scheduler, event driven.
+//
+// Each machine has a heap of its released operations, ordered by ready time
+// then duration, and the machines are kept in a heap by their next event
+// time: the time their best ready operation could start. The constructor
+// repeatedly takes the machine of the earliest event, picks one of the first
+// alpha fraction of its ready operations at random (the restricted candidate
+// list, popped off the top of the heap) and releases the next step of that
+// job. Machines without ready work leave the heap and re-enter it when work
+// is released to them, so time jumps straight to the next release.
+//
+// Scheduling is O(n log n) for n operations, and the constructor can be run
+// again and again on the same instance, e.g. for multi-start GRASP.
 class SolutionConstructor
 {
-    struct MachineScheduler
+    // a released operation waiting on its machine
+    struct ReadyStep
     {
-        MachineID machine_id;
-        TimeStamp current_time;
-        TimeStamp plan_time;
+        TimeStamp  ready_time;
+        TimePeriod duration;
+        OpID       op;
     };
 
-    struct StepScheduler
+    // machine heap entry, stale once the machine's version moved on
+    struct MachineEvent
     {
-        JobID      job_id;
-        StepID     step_id;
-        MachineID  machine_id;
-        TimePeriod duration;
-        bool       ready;
-        TimeStamp  ready_time;
-        TimeStamp  start_time;
-        TimeStamp  end_time;
+        TimeStamp     time;
+        MachineID     machine;
+        std::uint64_t version;
     };
 
 public:
+    // the constructor compiles and keeps its own copy of the instance
     void convert_from_instance(const JobShopInstance& instance)
     {
-        // add steps to waiting list
-        for (const auto& [job_id, job_obj] : instance.jobs()) {
-            for (const auto& [step_id, step_obj] : job_obj.steps) {
-                if (step_id == 0) {
-                    auto step_scheduler = StepScheduler{job_id,
-                                                        step_id,
-                                                        step_obj.machine_id,
-                                                        step_obj.duration,
-                                                        true,
-                                                        0,
-                                                        0,
-                                                        0};
-                    ready_list[step_obj.machine_id].push_back(step_scheduler);
-                }
-                else {
-                    waiting_list[{job_id, step_id}] =
-                        StepScheduler{job_id,
-                                      step_id,
-                                      step_obj.machine_id,
-                                      step_obj.duration,
-                                      false,
-                                      0,
-                                      0,
-                                      0};
-                }
-            }
-        }
-
-        // add machines
-        for (const auto& [machine_id, machine_obj] : instance.machines()) {
-            machines.push_back({machine_id, 0, 0});
-        }
+        owned_instance_ = std::make_unique<const CompiledInstance>(instance);
+        instance_       = owned_instance_.get();
     };
-
-    Solution schedule()
+    // the instance is not copied, it has to outlive the constructor
+    void convert_from_instance(const CompiledInstance& instance)
     {
-        Solution solution;
-
-        size_t total_steps = waiting_list.size();
-        for (const auto& [machine_id, machine_ready_list] : ready_list) {
-            total_steps += machine_ready_list.size();
-        }
+        owned_instance_.reset();
+        instance_ = &instance;
+    };
 
-        while (total_steps > 0) {
-            // 1. sort the machines by plan time with ranges
-            std::ranges::sort(machines, [](const auto& lhs, const auto& rhs) {
-                return lhs.plan_time < rhs.plan_time;
-            });
+    float alpha() const { return alpha_; }
+    void  set_alpha(float alpha) { alpha_ = alpha; }
 
+    // build one randomized schedule, start times indexed by OpID, returns
+    // its makespan
+    TimeStamp schedule(std::vector<TimeStamp>& start_times)
+    {
+        const auto durations = instance_->op_durations();
+        const auto machines  = instance_->op_machines();
+        auto&      rng       = thread_rng();
 
-            auto& selected_machine_ref = machines[0];
-            auto  selected_machine_id  = selected_machine_ref.machine_id;
+        ready_.resize(instance_->num_machines());
+        for (auto& heap : ready_) {
+            heap.clear();
+        }
+        machine_time_.assign(instance_->num_machines(), 0);
+        version_.assign(instance_->num_machines(), 0);
+        events_.clear();
+        order_.clear();
+        start_times.resize(instance_->num_ops());
+
+        auto push_event = [&](MachineID machine) {
+            const auto& heap = ready_[machine];
+            events_.push_back(
+                {std::max(machine_time_[machine], heap.front().ready_time),
+                 machine,
+                 ++version_[machine]});
+            std::ranges::push_heap(events_, later_event);
+        };
+        auto release = [&](OpID op, TimeStamp ready_time) {
+            auto& heap = ready_[machines[op]];
+            heap.push_back({ready_time, durations[op], op});
+            std::ranges::push_heap(heap, later_step);
+            push_event(machines[op]);
+        };
+
+        for (JobID job = 0; job < instance_->num_jobs(); ++job) {
+            if (instance_->job_begin(job) < instance_->job_end(job)) {
+                release(instance_->job_begin(job), 0);
+            }
+        }
 
-            // if the ready list of selected machine is empty, then increase the
-            // plan time and continue
-            if (ready_list[selected_machine_id].empty()) {
-                selected_machine_ref.plan_time += 3;
+        TimeStamp makespan = 0;
+        while (!events_.empty()) {
+            std::ranges::pop_heap(events_, later_event);
+            const MachineEvent event = events_.back();
+            events_.pop_back();
+            if (event.version != version_[event.machine]) {
                 continue;
             }
 
-            // 2. sort the ready_list of the machine by ready time and duration
-            // with ranges
-            std::ranges::sort(ready_list[selected_machine_id],
-                              [](const auto& lhs, const auto& rhs) {
-                                  //   return lhs.ready_time < rhs.ready_time;
-                                  if (lhs.ready_time == rhs.ready_time) {
-                                      return lhs.duration < rhs.duration;
-                                  }
-                                  else {
-                                      return lhs.ready_time < rhs.ready_time;
-                                  }
-                              });
-
-            // use GRASP algorithm to random select the step
-            size_t num_ready_steps = ready_list[selected_machine_id].size();
-            size_t ub_selected_step_index =
-                std::max(1UL, static_cast<size_t>(num_ready_steps * alpha));
-
-            std::random_device                    rnd_dev;
-            std::mt19937                          rnd_engine(rnd_dev());
-            std::uniform_int_distribution<size_t> step_index_distro(
-                0, ub_selected_step_index - 1);
-            size_t selected_step_index = step_index_distro(rnd_engine);
-
-            // 3. get the first step obj from the sorted ready_list
-            auto selected_step_obj =
-                ready_list[selected_machine_id][selected_step_index];
-            // del the selected step from the ready_list
-            ready_list[selected_machine_id].erase(
-                ready_list[selected_machine_id].begin() + selected_step_index);
-
-            TimeStamp start_time = std::max(selected_machine_ref.current_time,
-                                            selected_step_obj.ready_time);
-            TimeStamp end_time   = start_time + selected_step_obj.duration;
-
-            // 4. update the selected machine's current time and plan time
-            selected_machine_ref.current_time = end_time;
-            selected_machine_ref.plan_time =
-                std::max(selected_machine_ref.plan_time,
-                         selected_machine_ref.current_time);
-
-            // 5. update the selected step's start time and end time
-            selected_step_obj.start_time = start_time;
-            selected_step_obj.end_time   = end_time;
-
-
-            // create a steptask and add it to solution.step_tasks and
-            // schedules_
-            auto step_task = std::make_shared<StepTask>(
-                StepTask{selected_step_obj.machine_id,
-                         selected_step_obj.duration,
-                         selected_step_obj.start_time,
-                         selected_step_obj.end_time,
-                         selected_step_obj.job_id,
-                         selected_step_obj.step_id});
-
-            solution.step_tasks[{selected_step_obj.job_id,
-                                 selected_step_obj.step_id}] = step_task;
-            solution.schedules[selected_step_obj.machine_id].push_back(
-                std::weak_ptr<Task>(step_task));
-
-            total_steps -= 1;   // one step is scheduled
-
-            // 7. check if the next step is exist in waiting list
-            // if yes, then add it to the ready list
-            auto next_step_id = selected_step_obj.step_id + 1;
-            auto next_job_id  = selected_step_obj.job_id;
-            auto it           = waiting_list.find({next_job_id, next_step_id});
-            if (it != waiting_list.end()) {
-                auto next_step_obj  = it->second;
-                next_step_obj.ready = true;
-                next_step_obj.ready_time =
-                    selected_step_obj.end_time;   // update the ready time
-                ready_list[next_step_obj.machine_id].push_back(next_step_obj);
-                waiting_list.erase({next_job_id, next_step_id});
+            // use GRASP algorithm to random select the step: one of the
+            // first alpha fraction of the ready list
+            const MachineID machine = event.machine;
+            auto&           heap    = ready_[machine];
+            const size_t    num_candidates =
+                std::max<size_t>(1, static_cast<size_t>(heap.size() * alpha_));
+            std::uniform_int_distribution<size_t> candidate_distro(
+                0, num_candidates - 1);
+            const size_t selected = candidate_distro(rng);
+
+            candidates_.clear();
+            for (size_t i = 0; i <= selected; ++i) {
+                std::ranges::pop_heap(heap, later_step);
+                candidates_.push_back(heap.back());
+                heap.pop_back();
+            }
+            const ReadyStep step = candidates_.back();
+            candidates_.pop_back();
+            for (const ReadyStep& candidate : candidates_) {
+                heap.push_back(candidate);
+                std::ranges::push_heap(heap, later_step);
+            }
+
+            const TimeStamp start_time =
+                std::max(machine_time_[machine], step.ready_time);
+            const TimeStamp end_time = start_time + step.duration;
+            start_times[step.op]     = start_time;
+            machine_time_[machine]   = end_time;
+            makespan                 = std::max(makespan, end_time);
+            order_.push_back(step.op);
+
+            // release the next step of the job
+            const JobID job = instance_->op_jobs()[step.op];
+            if (step.op + 1 < instance_->job_end(job)) {
+                release(step.op + 1, end_time);
+            }
+            if (!heap.empty()) {
+                push_event(machine);
+            }
+            else {
+                ++version_[machine];
             }
         }
 
+        return makespan;
+    };
+
+    Solution schedule()
+    {
+        Solution solution(*instance_);
+        schedule(solution.start_times);
+
+        // operations were scheduled in start time order on each machine
+        const auto        durations = instance_->op_durations();
+        const auto        machines  = instance_->op_machines();
+        std::vector<OpID> machine_next(instance_->machine_offsets().begin(),
+                                       instance_->machine_offsets().end() - 1);
+        for (OpID op : order_) {
+            solution.end_times[op] = solution.start_times[op] + durations[op];
+            solution.machine_sequences[machine_next[machines[op]]++] = op;
+        }
+
         solution.update_makespan();
 
         return solution;
@@ -182,10 +180,30 @@ public:
 
 
 private:
-    float                                           alpha = 0.3F;
-    std::vector<MachineScheduler>                   machines;
-    std::map<MachineID, std::vector<StepScheduler>> ready_list;
-    std::map<TaskID, StepScheduler>                 waiting_list;
+    // heap orders (std heaps are max heaps)
+    static bool later_step(const ReadyStep& lhs, const ReadyStep& rhs)
+    {
+        if (lhs.ready_time == rhs.ready_time) {
+            return lhs.duration > rhs.duration;
+        }
+        return lhs.ready_time > rhs.ready_time;
+    }
+    static bool later_event(const MachineEvent& lhs, const MachineEvent& rhs)
+    {
+        return lhs.time > rhs.time;
+    }
+
+    float                                   alpha_    = 0.3F;
+    const CompiledInstance*                 instance_ = nullptr;
+    std::unique_ptr<const CompiledInstance> owned_instance_;
+
+    // scheduling state, kept to reuse the buffers between schedules
+    std::vector<std::vector<ReadyStep>> ready_;
+    std::vector<TimeStamp>              machine_time_;
+    std::vector<std::uint64_t>          version_;
+    std::vector<MachineEvent>           events_;
+    std::vector<ReadyStep>              candidates_;
+    std::vector<OpID>                   order_;
 };
 
-}   // namespace scheduling
\ No newline at end of file
+}   // namespace scheduling
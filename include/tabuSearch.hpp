@@ -0,0 +1,89 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "algorithm.hpp"
+#include "compiledInstance.hpp"
+#include "disjunctiveGraph.hpp"
+#include "incumbent.hpp"
+#include "types.hpp"
+
+namespace scheduling {
+
+// Tabu search over the disjunctive graph (S2).
+//
+// Moves come from the critical blocks of the current graph: N5 swaps the
+// first two / last two operations of a block (Nowicki & Smutnicki), N7 also
+// moves an inner operation of a block to the block's first or last position
+// and the first or last operation into the block (Zhang et al.). Moves are
+// scored with head/tail based makespan estimates (Taillard, Balas &
+// Vazacopoulos): only the operations whose machine order changes are
+// re-timed, against the unchanged heads and tails of their neighbors, so a
+// swap costs O(1) and an insertion O(block length). Only the chosen move is
+// applied and the graph fully updated.
+//
+// Each worker runs its own search, starting from the incumbent, and
+// publishes its improvements into it.
+class TabuSearchAlgorithm : public Algorithm
+{
+public:
+    enum class Neighborhood
+    {
+        N5,
+        N7
+    };
+
+    struct Move
+    {
+        MachineID machine;
+        size_t    from;       // position of the moved operation
+        size_t    to;         // its position after the move
+        OpID      moved;      // the moved operation
+        OpID      pivot;      // the operation it jumps over last
+        TimeStamp estimate;   // estimated makespan after the move
+    };
+
+    TabuSearchAlgorithm(int num_threads, int time_limit,
+                        Neighborhood neighborhood   = Neighborhood::N7,
+                        int          max_no_improve = 2000)
+        : Algorithm(num_threads, time_limit)
+        , neighborhood_(neighborhood)
+        , max_no_improve_(max_no_improve){};
+
+    void solve(const CompiledInstance& instance, Incumbent& incumbent) override;
+
+    // the candidate moves of the graph's critical blocks, with estimates
+    static void generate_moves(const DisjunctiveGraph& graph,
+                               Neighborhood            neighborhood,
+                               std::vector<Move>&      moves);
+
+    // head/tail estimate of the makespan after moving machine position from
+    // to position to
+    static TimeStamp estimate_move(const DisjunctiveGraph& graph,
+                                   MachineID machine, size_t from, size_t to);
+
+private:
+    // an arc (before, after) of a machine order that may not be restored
+    // until the given iteration
+    struct TabuArc
+    {
+        OpID          before;
+        OpID          after;
+        std::uint64_t expires;
+    };
+
+    void search(const CompiledInstance& instance, Incumbent& incumbent,
+                std::atomic<bool>& stop, int worker) const;
+
+    static void perturb(DisjunctiveGraph& graph, int num_moves);
+    static bool is_tabu(const std::vector<TabuArc>& tabu_list,
+                        const Move& move, std::uint64_t iteration);
+
+    Neighborhood neighborhood_;
+    int          max_no_improve_;
+};
+
+}   // namespace scheduling
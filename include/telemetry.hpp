@@ -0,0 +1,108 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <thread>
+
+#include "incumbent.hpp"
+
+namespace scheduling {
+
+// Solver telemetry: per-thread event counters, cheap enough for the hot
+// loops, summed on demand.
+//
+// Every thread that counts gets its own cache line of counters; the owner
+// is its only writer (a relaxed load and store, no locked instruction), and
+// readers sum the live slots plus the counts of the threads that exited.
+enum class Counter : size_t
+{
+    DECODES,        // makespan decodes, full or incremental
+    GENERATIONS,    // GA generations
+    CROSSOVERS,     // GA crossovers (two children each)
+    MUTATIONS,      // GA mutations
+    ITERATIONS,     // tabu, LNS and GRASP iterations
+    IMPROVEMENTS,   // improvements published into the incumbent
+    LOCK_WAIT_NS,   // time spent waiting on contended locks
+    NUM_COUNTERS
+};
+
+constexpr size_t NUM_COUNTERS = static_cast<size_t>(Counter::NUM_COUNTERS);
+using CounterValues           = std::array<std::uint64_t, NUM_COUNTERS>;
+
+const char* counter_name(Counter counter);
+
+struct alignas(64) ThreadCounters
+{
+    std::array<std::atomic<std::uint64_t>, NUM_COUNTERS> values{};
+};
+
+// the calling thread's slot, registered on first use
+ThreadCounters& thread_counters();
+
+inline void count(Counter counter, std::uint64_t value = 1)
+{
+    auto& slot = thread_counters().values[static_cast<size_t>(counter)];
+    slot.store(slot.load(std::memory_order_relaxed) + value,
+               std::memory_order_relaxed);
+}
+
+// sum over all threads since the start of the process
+CounterValues counter_totals();
+
+// Lock a mutex, counting the time spent waiting for it when it is
+// contended. An uncontended lock costs one try_lock.
+template<typename Lock> void timed_lock(Lock& lock)
+{
+    if (lock.try_lock()) {
+        return;
+    }
+    const auto start = std::chrono::steady_clock::now();
+    lock.lock();
+    count(Counter::LOCK_WAIT_NS,
+          std::chrono::duration_cast<std::chrono::nanoseconds>(
+              std::chrono::steady_clock::now() - start)
+              .count());
+}
+
+// Background thread that writes one JSON line of progress every interval:
+// the elapsed time, the incumbent makespan and lower bound, and every
+// counter since the reporter started with its rate over the last interval.
+// A last line is written when the reporter is destroyed.
+class TelemetryReporter
+{
+public:
+    TelemetryReporter(std::ostream& out, std::chrono::milliseconds interval,
+                      const Incumbent& incumbent);
+    ~TelemetryReporter();
+
+    TelemetryReporter(const TelemetryReporter&)            = delete;
+    TelemetryReporter& operator=(const TelemetryReporter&) = delete;
+    TelemetryReporter(TelemetryReporter&&)                 = delete;
+    TelemetryReporter& operator=(TelemetryReporter&&)      = delete;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    void report();
+
+    std::ostream&             out_;
+    std::chrono::milliseconds interval_;
+    const Incumbent&          incumbent_;
+    Clock::time_point         start_;
+    Clock::time_point         last_time_;
+    CounterValues             baseline_;
+    CounterValues             last_;
+
+    std::mutex              mutex_;
+    std::condition_variable wake_;
+    bool                    stop_ = false;
+    std::thread             thread_;
+};
+
+}   // namespace scheduling
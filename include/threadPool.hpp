@@ -0,0 +1,102 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace scheduling {
+
+// Work-stealing task pool shared by all algorithms of a Run.
+//
+// Each worker owns a deque: tasks submitted from a worker go to the back of
+// its own deque and are popped LIFO, other tasks are spread round-robin over
+// the workers. An idle worker steals from the front of the other deques
+// before going to sleep. Algorithms submit fine-grained jobs (decode batches,
+// neighborhood evaluations, subproblems), mostly through parallel_for(), in
+// which the calling thread takes part, so it also works from inside a task.
+//
+// The long-running workers of the algorithms (GA islands, searches) run as
+// jobs of the same pool, so the pool's workers are the only threads doing
+// the work of a run. A job keeps its worker until it returns, so the pool
+// needs more workers than jobs for the tasks of the jobs to run anywhere
+// but on the worker that submitted them. Jobs have a queue of their own,
+// which only idle workers take from: a worker helping out while it waits in
+// parallel_for() never gets stuck in a job.
+class ThreadPool
+{
+public:
+    using Task = std::function<void()>;
+
+    struct WorkerStats
+    {
+        std::uint64_t tasks   = 0;   // tasks executed
+        std::uint64_t steals  = 0;   // tasks taken from another worker
+        std::uint64_t busy_ns = 0;   // time spent running tasks
+        std::uint64_t idle_ns = 0;   // time spent looking for work / asleep
+    };
+
+    // cpu_set: when not empty, worker i is pinned to cpu_set[i % size]
+    explicit ThreadPool(int num_workers, std::vector<int> cpu_set = {});
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&)            = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ThreadPool(ThreadPool&&)                 = delete;
+    ThreadPool& operator=(ThreadPool&&)      = delete;
+
+    void submit(Task task);
+    // run a long-running job on the next idle worker
+    void submit_job(Task job);
+
+    // run body(i) for every i in [0, count), grain indices per job, and
+    // return once all of them are done
+    void parallel_for(size_t count, const std::function<void(size_t)>& body,
+                      size_t grain = 1);
+
+    int num_workers() const { return static_cast<int>(workers_.size()); }
+
+    // index of the calling thread in this pool, -1 for other threads
+    int current_worker() const;
+
+    std::vector<WorkerStats> stats() const;
+    void                     print_stats(std::ostream& out = std::cout) const;
+
+private:
+    struct alignas(64) Worker
+    {
+        std::mutex       mtx;
+        std::deque<Task> tasks;
+
+        std::atomic<std::uint64_t> executed{0};
+        std::atomic<std::uint64_t> stolen{0};
+        std::atomic<std::uint64_t> busy_ns{0};
+        std::atomic<std::uint64_t> idle_ns{0};
+    };
+
+    void worker_loop(int index, int cpu);
+    bool try_pop(int index, Task& task);
+    bool try_steal(int index, Task& task);
+    bool try_take_job(Task& job);
+    bool run_one(int index);
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::vector<std::thread>             threads_;
+    std::mutex                           jobs_mtx_;
+    std::deque<Task>                     jobs_;
+
+    std::atomic<bool>       stop_{false};
+    std::atomic<size_t>     pending_{0};
+    std::atomic<size_t>     next_worker_{0};
+    std::mutex              sleep_mtx_;
+    std::condition_variable sleep_cv_;
+};
+
+}   // namespace scheduling
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <span>
 #include <string>
 #include <utility>
 #include <vector>
@@ -12,8 +13,12 @@ using MachineID  = unsigned int;
 using TimeStamp  = unsigned int;
 using TimePeriod = unsigned int;
 using Fitness    = unsigned int;
+using OpID       = unsigned int;
 using TaskID     = std::pair<JobID, StepID>;
 using Chromosome = std::vector<unsigned int>;
+// genes stored in place, e.g. a row of a PopulationArena
+using ChromosomeRef      = std::span<unsigned int>;
+using ConstChromosomeRef = std::span<const unsigned int>;
 
 enum class TaskType
 {
@@ -1,20 +1,32 @@
 #include "algorithm.hpp"
+#include "batchDecoder.hpp"
+#include "compiledInstance.hpp"
+#include "decoder.hpp"
+#include "disjunctiveGraph.hpp"
+#include "incumbent.hpp"
 #include "jobShopInstance.hpp"
+#include "populationArena.hpp"
+#include "random.hpp"
 #include "solution.hpp"
 #include "solutionConstructor.hpp"
+#include "telemetry.hpp"
 #include "types.hpp"
 
 #include <algorithm>
+#include <array>
 #include <atomic>
+#include <chrono>
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <iostream>
 #include <limits>
 #include <map>
 #include <memory>
+#include <numeric>
 #include <random>
-#include <set>
+#include <span>
 #include <thread>
 #include <utility>
 #include <vector>
@@ -22,29 +34,93 @@
 
 namespace scheduling {
 
+void Algorithm::run_workers(
+    const Incumbent&                                         incumbent,
+    const std::function<void(int worker, std::atomic<bool>& stop)>& body)
+    const
+{
+    if (num_thread_ <= 0) {
+        return;
+    }
+    std::atomic<bool> stop{false};
+    std::atomic<bool> finished{false};
+    std::atomic<int>  running{num_thread_};
+
+    auto run_worker = [&](int worker) {
+        init_worker(worker);
+        body(worker, stop);
+        if (running.fetch_sub(1) == 1) {
+            finished = true;
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < num_thread_; ++i) {
+        if (pool_ != nullptr) {
+            pool_->submit_job([&run_worker, i]() { run_worker(i); });
+        }
+        else {
+            threads.emplace_back(run_worker, i);
+        }
+    }
+
+    // Wait for the time limit, the last worker, or until the gap is closed
+    wait_for_time_limit(incumbent, &finished);
+
+    // Notify the workers to stop, the jobs that have not started yet stop
+    // right away
+    stop = true;
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    while (!finished.load()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+DisjunctiveGraph Algorithm::start_graph(const CompiledInstance& instance,
+                                        const Incumbent&        incumbent)
+{
+    if (auto snapshot = incumbent.snapshot();
+        snapshot != nullptr && !snapshot->empty()) {
+        DisjunctiveGraph graph =
+            DisjunctiveGraph::from_solution(*snapshot, instance);
+        if (graph.update()) {
+            return graph;
+        }
+    }
+    return DisjunctiveGraph::from_chromosome(
+        GAAlgorithm::encode(instance).chromosome, instance);
+}
+
+DisjunctiveGraph Algorithm::seed_graph(const CompiledInstance& instance,
+                                       const Incumbent&        incumbent,
+                                       int                     worker) const
+{
+    if (static_cast<size_t>(worker) < seeds_.size()) {
+        return DisjunctiveGraph::from_chromosome(seeds_[worker].chromosome,
+                                                 instance);
+    }
+    return start_graph(instance, incumbent);
+}
 
 Individual GAAlgorithm::encode(const Solution& solution)
 {
     Individual individual;
     individual.fitness = solution.makespan;
-    individual.chromosome.reserve(solution.step_tasks.size());
+    individual.chromosome.reserve(solution.num_ops());
 
-    // retrive the tasks from solution.step_tasks_ and store them in a vector
-    std::vector<std::shared_ptr<StepTask>> tasks;
-    tasks.reserve(solution.step_tasks.size());
-    for (const auto& [task_id, task] : solution.step_tasks) {
-        tasks.push_back(task);
-    }
-
-    // sort the tasks by start time
-    std::sort(tasks.begin(), tasks.end(), [](const auto& lhs, const auto& rhs) {
-        return lhs->start_time < rhs->start_time;
+    // sort the operations by start time, ties in job order
+    std::vector<OpID> ops(solution.num_ops());
+    std::iota(ops.begin(), ops.end(), 0);
+    std::ranges::stable_sort(ops, [&](OpID lhs, OpID rhs) {
+        return solution.start_times[lhs] < solution.start_times[rhs];
     });
 
-    // retrive the job_id of each task in the sorted tasks, and push them into
-    // the chromosome
-    for (const auto& task : tasks) {
-        individual.chromosome.push_back(task->job_id);
+    // retrive the job_id of each operation in the sorted operations, and
+    // push them into the chromosome
+    for (OpID op : ops) {
+        individual.chromosome.push_back(solution.job_ids[op]);
     }
 
     return individual;
@@ -52,439 +128,502 @@ Individual GAAlgorithm::encode(const Solution& solution)
 
 Individual GAAlgorithm::encode(const JobShopInstance& instance)
 {
-    size_t total_steps = 0;
-    for (const auto& job : instance.jobs()) {
-        total_steps += job.second.steps.size();
-    }
+    return encode(CompiledInstance(instance));
+}
 
+Individual GAAlgorithm::encode(const CompiledInstance& instance)
+{
     Individual individual;
-    individual.chromosome.reserve(total_steps);
+    individual.chromosome.reserve(instance.num_ops());
 
-
-    for (const auto& [job_id, job_obj] : instance.jobs()) {
-        //  add job_obj.steps.size() times the job_id to the chromosome
+    for (JobID job = 0; job < instance.num_jobs(); ++job) {
+        //  add the number of steps of the job times the job_id
         std::fill_n(std::back_inserter(individual.chromosome),
-                    job_obj.steps.size(),
-                    job_id);
+                    instance.job_end(job) - instance.job_begin(job),
+                    instance.job_ids()[job]);
     }
 
     //  shuffle the chromosome
     std::shuffle(individual.chromosome.begin(),
                  individual.chromosome.end(),
-                 std::mt19937(std::random_device()()));
+                 thread_rng());
 
-    Solution sol       = decode(individual.chromosome, instance);
-    individual.fitness = sol.makespan;
+    individual.fitness = decode_makespan(individual.chromosome, instance);
     return individual;
 }
 
-Solution GAAlgorithm::decode(const Chromosome&      chromosome,
+Solution GAAlgorithm::decode(ConstChromosomeRef     chromosome,
                              const JobShopInstance& instance)
 {
-    Solution solution{};   // solution obj to be returned
+    return decode(chromosome, CompiledInstance(instance));
+}
 
-    // machine end time map
-    std::map<MachineID, TimeStamp> machine_end_times;
-    for (const auto& [machine_id, machine] : instance.machines()) {
-        machine_end_times[machine_id] = 0;
+Solution GAAlgorithm::decode(ConstChromosomeRef      chromosome,
+                             const CompiledInstance& instance,
+                             DecodeMode mode, double delay)
+{
+    if (mode == DecodeMode::SEMI_ACTIVE) {
+        return decode(chromosome, instance);
     }
+    std::vector<TimeStamp> start_times(instance.num_ops());
+    decode_schedule(chromosome, instance, mode, delay, start_times);
+    return DisjunctiveGraph::from_start_times(start_times, instance)
+        .to_solution();
+}
 
-    // job current step map, job end time map
-    std::map<JobID, StepID>    job_curr_step;
-    std::map<JobID, TimeStamp> job_end_time;
-    for (const auto& [job_id, job] : instance.jobs()) {
-        job_curr_step[job_id] = 0;
-        job_end_time[job_id]  = 0;
-    }
+Solution GAAlgorithm::decode(ConstChromosomeRef      chromosome,
+                             const CompiledInstance& instance)
+{
+    count(Counter::DECODES);
+    Solution solution(instance);   // solution obj to be returned
 
-    // for each gene in the chromosome, get the job_id, step_id, machine_id,
+    std::vector<TimeStamp> machine_end_times(instance.num_machines(), 0);
+    std::vector<OpID>      machine_next(instance.machine_offsets().begin(),
+                                   instance.machine_offsets().end() - 1);
+    std::vector<TimeStamp> job_end_time(instance.num_jobs(), 0);
+    std::vector<OpID>      job_next_op(instance.job_offsets().begin(),
+                                  instance.job_offsets().end() - 1);
+
+    // for each gene in the chromosome, get the job, operation, machine,
     // start end time, and update the machine_end_times, job_end_time,
-    // job_curr_step
+    // job_next_op
     for (JobID job_id : chromosome) {
-        StepID    step_id = job_curr_step[job_id];
-        MachineID machine_id =
-            instance.jobs().at(job_id).steps.at(step_id).machine_id;
-        TimeStamp start_time =
-            std::max(machine_end_times[machine_id], job_end_time[job_id]);
-        TimeStamp end_time =
-            start_time + instance.jobs().at(job_id).steps.at(step_id).duration;
+        const JobID     job     = instance.job_index(job_id);
+        const OpID      op      = job_next_op[job]++;
+        const MachineID machine = instance.op_machines()[op];
 
-        machine_end_times[machine_id] = end_time;
-        job_end_time[job_id]          = end_time;
-        job_curr_step[job_id]         = step_id + 1;
+        TimeStamp start_time =
+            std::max(machine_end_times[machine], job_end_time[job]);
+        TimeStamp end_time = start_time + instance.op_durations()[op];
 
-        solution.step_tasks[{job_id, step_id}] = std::make_shared<StepTask>(
-            machine_id,
-            instance.jobs().at(job_id).steps.at(step_id).duration,
-            start_time,
-            end_time,
-            job_id,
-            step_id);
+        machine_end_times[machine] = end_time;
+        job_end_time[job]          = end_time;
 
-        solution.schedules[machine_id].push_back(
-            solution.step_tasks[{job_id, step_id}]);
+        solution.start_times[op] = start_time;
+        solution.end_times[op]   = end_time;
+        solution.machine_sequences[machine_next[machine]++] = op;
 
         solution.makespan = std::max(solution.makespan, end_time);
     }
 
-    solution.chromo = chromosome;
+    solution.chromo.assign(chromosome.begin(), chromosome.end());
 
     return solution;
 }
 
-Individual GAAlgorithm::tournament_selection(const Population& population)
+size_t GAAlgorithm::tournament_selection(std::span<const Fitness> fitness)
 {
-    std::vector<Individual> tournament;
-    tournament.reserve(5);
-
-    std::random_device                    random_dev;
-    std::mt19937                          rng(random_dev());
-    std::uniform_int_distribution<size_t> dist(0, population.size() - 1);
-
-    for (int i = 0; i < 5; i++) {
-        tournament.push_back(population[dist(rng)]);
+    auto&                                 rng = thread_rng();
+    std::uniform_int_distribution<size_t> dist(0, fitness.size() - 1);
+
+    size_t best = dist(rng);
+    for (int i = 1; i < 5; i++) {
+        const size_t candidate = dist(rng);
+        if (fitness[candidate] < fitness[best]) {
+            best = candidate;
+        }
     }
-    auto best = std::min_element(tournament.begin(),
-                                 tournament.end(),
-                                 [](const auto& lhs, const auto& rhs) {
-                                     return lhs.fitness < rhs.fitness;
-                                 });
-    return *best;
+    return best;
 }
 
 
-std::pair<Chromosome, Chromosome> GAAlgorithm::crossover(
-    const Individual& parent1, const Individual& parent2)
+void GAAlgorithm::crossover(ConstChromosomeRef parent1,
+                            ConstChromosomeRef parent2, ChromosomeRef child1,
+                            ChromosomeRef child2)
 {
-    JobID              max_job_id = std::ranges::max(parent1.chromosome);
-    std::random_device rnd;
-    std::mt19937       rng(rnd());
+    JobID max_job_id = std::ranges::max(parent1);
+    auto& rng        = thread_rng();
     std::uniform_int_distribution<size_t> dist(0 + 2, max_job_id - 2);
 
-    JobID split_job_id = dist(rng);
-
-    std::set<JobID> group_one;
-    std::set<JobID> group_two;
+    // the jobs below the split are group one, the others group two
+    const JobID split_job_id = dist(rng);
 
-    for (const auto& job_id : parent1.chromosome) {
-        if (job_id < split_job_id) {
-            group_one.insert(job_id);
+    // child1 keeps the genes of group one of parent1 in place, and takes the
+    // genes of group two in the order of parent2
+    size_t next = 0;
+    for (size_t i = 0; i < parent1.size(); ++i) {
+        if (parent1[i] < split_job_id) {
+            child1[i] = parent1[i];
+            continue;
         }
-        else {
-            group_two.insert(job_id);
-        }
-    }
-
-    Chromosome         child1;
-    std::vector<JobID> reserve1;
-    child1.resize(parent1.chromosome.size());
-    // child1.resize(parent1.chromosome.size());
-
-    Chromosome         child2;
-    std::vector<JobID> reserve2;
-    // child2.reserve(parent1.chromosome.size());
-    child2.resize(parent1.chromosome.size());
-
-    for (JobID parent2_job_id : parent2.chromosome) {
-        if (group_two.contains(parent2_job_id)) {
-            reserve1.push_back(parent2_job_id);
+        while (parent2[next] < split_job_id) {
+            ++next;
         }
+        child1[i] = parent2[next++];
     }
-    // reverse reserve1, so we can pop from the back
-    std::reverse(reserve1.begin(), reserve1.end());
 
-    for (JobID parent1_job_id : parent1.chromosome) {
-        if (group_one.contains(parent1_job_id)) {
-            reserve2.push_back(parent1_job_id);
+    // child2 keeps the genes of group two of parent2 in place, and takes the
+    // genes of group one in the order of parent1
+    next = 0;
+    for (size_t i = 0; i < parent2.size(); ++i) {
+        if (parent2[i] >= split_job_id) {
+            child2[i] = parent2[i];
+            continue;
         }
-    }
-    // reverse reserve2
-    std::reverse(reserve2.begin(), reserve2.end());
-
-    for (JobID i = 0; i < parent1.chromosome.size(); ++i) {
-        if (group_one.contains(parent1.chromosome[i])) {
-            child1[i] = parent1.chromosome[i];
-        }
-        else {
-            child1[i] = reserve1.back();
-            reserve1.pop_back();
-        }
-    }
-
-    for (JobID i = 0; i < parent2.chromosome.size(); ++i) {
-        if (group_two.contains(parent2.chromosome[i])) {
-            child2[i] = parent2.chromosome[i];
-        }
-        else {
-            child2[i] = reserve2.back();
-            reserve2.pop_back();
+        while (parent1[next] >= split_job_id) {
+            ++next;
         }
+        child2[i] = parent1[next++];
     }
-
-    return {std::move(child1), std::move(child2)};
 }
 
 void GAAlgorithm::mutation(Individual&            individual,
                            const JobShopInstance& instance)
+{
+    mutation(individual, CompiledInstance(instance));
+}
+
+void GAAlgorithm::mutation(Individual&              individual,
+                           const CompiledInstance& instance)
+{
+    individual.fitness = mutation(individual.chromosome, instance);
+}
+
+Fitness GAAlgorithm::mutation(ChromosomeRef           chromosome,
+                              const CompiledInstance& instance,
+                              DecodeMode mode, double delay)
 {
     // random select 3 position of the chromosome, and generate all
     // permutations（with swap the value of 3 values）, then select the one with
     // best fitness
-    std::random_device                    random_device;
-    std::mt19937                          random_engine(random_device());
-    std::uniform_int_distribution<size_t> dist(
-        0, individual.chromosome.size() - 1);
+    auto&                                 random_engine = thread_rng();
+    std::uniform_int_distribution<size_t> dist(0, chromosome.size() - 1);
 
     // random select 3 diff position with 3 diff values from the chromosome
-    std::vector<size_t> positions;
-    std::vector<JobID>  candidate_job_list;
-    while (candidate_job_list.size() < 3) {
+    std::array<size_t, 3> positions{};
+    std::array<JobID, 3>  candidate_job_list{};
+    size_t                num_selected = 0;
+    while (num_selected < 3) {
         auto selected_position = dist(random_engine);
-        auto selected_job      = individual.chromosome[selected_position];
-        if (std::find(candidate_job_list.begin(),
-                      candidate_job_list.end(),
-                      selected_job) == candidate_job_list.end()) {
-            positions.push_back(selected_position);
-            candidate_job_list.push_back(selected_job);
+        auto selected_job      = chromosome[selected_position];
+        auto selected_end      = candidate_job_list.begin() + num_selected;
+        if (std::find(candidate_job_list.begin(), selected_end, selected_job) ==
+            selected_end) {
+            positions[num_selected]          = selected_position;
+            candidate_job_list[num_selected] = selected_job;
+            ++num_selected;
         }
     }
 
     // Sort the values
     std::ranges::sort(candidate_job_list);
 
-    // Create a vector with the values at the three positions
-    std::vector<JobID> values = {individual.chromosome[positions[0]],
-                                 individual.chromosome[positions[1]],
-                                 individual.chromosome[positions[2]]};
+    // Evaluate all permutations in place on the chromosome, and keep the one
+    // with best fitness. Semi-active, only the genes from the first selected
+    // position on are re-decoded, and a permutation stops once it can't be
+    // the best; the other modes decode the whole chromosome.
+    thread_local IncrementalDecoder decoder;
 
-    // Generate all permutations
-    std::vector<Chromosome> permutations;
-    while (std::next_permutation(candidate_job_list.begin(),
-                                 candidate_job_list.end())) {
-        Chromosome new_chromosome    = individual.chromosome;
-        new_chromosome[positions[0]] = candidate_job_list[0];
-        new_chromosome[positions[1]] = candidate_job_list[1];
-        new_chromosome[positions[2]] = candidate_job_list[2];
-        permutations.push_back(new_chromosome);
+    const bool incremental = mode == DecodeMode::SEMI_ACTIVE;
+    if (incremental) {
+        decoder.reset(chromosome, instance);
     }
+    const auto [first_changed, last_changed] = std::ranges::minmax(positions);
 
-    // Select the one with best fitness
-    std::vector<Solution> solutions;
-    solutions.reserve(permutations.size());
-    for (const auto& chromosome : permutations) {
-        solutions.push_back(decode(chromosome, instance));
+    std::array<JobID, 3> best_permutation{};
+    Fitness              best_fitness = std::numeric_limits<Fitness>::max();
+    while (std::next_permutation(candidate_job_list.begin(),
+                                 candidate_job_list.end())) {
+        chromosome[positions[0]] = candidate_job_list[0];
+        chromosome[positions[1]] = candidate_job_list[1];
+        chromosome[positions[2]] = candidate_job_list[2];
+
+        Fitness fitness =
+            incremental ? decoder.evaluate(
+                              chromosome, first_changed, last_changed,
+                              best_fitness)
+                        : decode_schedule(chromosome, instance, mode, delay);
+        if (fitness < best_fitness) {
+            best_fitness     = fitness;
+            best_permutation = candidate_job_list;
+        }
     }
 
-    std::ranges::sort(solutions, [](const auto& lhs, const auto& rhs) {
-        return lhs.makespan < rhs.makespan;
-    });
-
-    auto best_solution = std::move(solutions[0]);
-
-    // update the individual
-    individual.fitness    = best_solution.makespan;
-    individual.chromosome = best_solution.chromo;
+    // keep the best permutation
+    chromosome[positions[0]] = best_permutation[0];
+    chromosome[positions[1]] = best_permutation[1];
+    chromosome[positions[2]] = best_permutation[2];
+    return best_fitness;
 }
 
-void GAAlgorithm::solve(const JobShopInstance& instance, Solution& global_best,
-                        std::shared_mutex& gbest_mtx)
+void GAAlgorithm::solve(const CompiledInstance& instance,
+                        Incumbent&              incumbent)
 {
-    // multi-threading GA algorithm implementation
-    // 1. each thread has its own population,
-    // 2. update global best solution with mutex when better solution found
-    // 3. update local best solution with mutex when better solutions found
+    // island model GA:
+    // 1. each worker evolves its own persistent population (island),
+    // 2. islands publish improvements into the lock-free incumbent,
+    // 3. every migration interval, an island sends copies of its best
+    //    individuals to another island through a lock-free mailbox, and
+    //    takes in the immigrants waiting for it at every generation
 
     std::cout << "solve from ga algorithm solve func" << '\n';
 
-    const int         NUM_PBESTS = 10;
-    std::atomic<bool> stop{false};
-    pbests_.reserve(NUM_PBESTS);
-
-    // create initial pbests
-    for (int i = 0; i < NUM_PBESTS; i++) {
-        pbests_.push_back(encode(instance));
-    }
-
-    // single_thread_ga(instance, global_best, gbest_mtx);
+    decode_isa_ = fastest_decode_isa(instance);
 
-    // Run the GA algorithm in multiple threads
-    std::vector<std::thread> threads;
-    threads.reserve(num_thread_);
-    for (int i = 0; i < num_thread_; ++i) {
-        threads.emplace_back(
-            [this, &instance, &global_best, &gbest_mtx, &stop]() {
-                while (!stop.load()) {
-                    this->single_thread_ga(
-                        instance, global_best, gbest_mtx, stop);
-                }
-            });
+    mailboxes_.clear();
+    mailboxes_.reserve(static_cast<size_t>(num_thread_) * num_thread_);
+    for (int i = 0; i < num_thread_ * num_thread_; ++i) {
+        mailboxes_.push_back(
+            std::make_unique<Mailbox>(std::max(4 * migration_size_, 1)));
     }
 
-    // Wait for the specified time limit
-    std::this_thread::sleep_for(std::chrono::seconds(time_limit_));
+    populations_.assign(num_thread_, Population{});
 
-    // Notify the GA algorithm to stop
-    stop = true;
-
-    // Wait for all threads to finish
-    for (auto& thread : threads) {
-        if (thread.joinable()) {
-            std::cout << "Thread is still running.\n";
-            thread.join();
-        }
-        else {
-            std::cout << "Thread has finished.\n";
-        }
-    }
+    // one island per worker, until the time limit
+    run_workers(incumbent, [&](int island, std::atomic<bool>& stop) {
+        run_island(instance, incumbent, stop, island);
+    });
+    mailboxes_.clear();
 }
 
-void GAAlgorithm::single_thread_ga(const JobShopInstance& instance,
-                                   Solution&              global_best,
-                                   std::shared_mutex&     gbest_mtx,
-                                   std::atomic<bool>&     stop)
+void GAAlgorithm::run_island(const CompiledInstance&  instance,
+                             Incumbent&               incumbent,
+                             const std::atomic<bool>& stop, int island)
 {
-    Population population;
-    population.reserve(population_size_);
-    for (int i = 0; i < population_size_; i++) {
-        population.push_back(encode(instance));
-    }
-
-
-    std::random_device rand_dev;
-    std::mt19937       rand_engine(rand_dev());
-
+    // parent and child generations, swapped every generation; the last
+    // crossover can overshoot the population size by one child
+    const size_t    capacity = population_size_ + 1;
+    PopulationArena parents(capacity, instance.num_ops());
+    PopulationArena children(capacity, instance.num_ops());
+    size_t          num_parents = population_size_;
+
+    // the tasks of a generation draw from streams of their own, derived
+    // from the island's one and the row they write, so that runs with the
+    // same master seed are reproducible whichever workers of the pool run
+    // them
+    const std::uint64_t island_stream = worker_stream(island);
+    std::uint64_t       generation_stream = task_stream(island_stream, 0);
+
+    // the initial population is encoded as one batch on the shared pool,
+    // seeded with the starting points
+    parallel_for(num_parents, [&](size_t i) {
+        const ScopedThreadStream stream(task_stream(generation_stream, i));
+        parents.assign(i, i < seeds_.size() ? seeds_[i] : encode(instance));
+        // the seeds and encode carry the semi-active fitness
+        if (decode_mode_ != DecodeMode::SEMI_ACTIVE) {
+            parents.fitness(i) = evaluate(parents.chromosome(i), instance);
+        }
+    });
 
-    while (!stop.load()) {
 
-        // sort the population by fitness
-        std::ranges::sort(population, [](const auto& lhs, const auto& rhs) {
-            return lhs.fitness < rhs.fitness;
+    auto& rand_engine = thread_rng();
+
+    // offspring of a generation that still have to be evaluated: mutated
+    // parents (mutation picks the best of its permutations) and crossover
+    // children, which are decoded in SIMD batches. They are evaluated as
+    // one batch of tasks on the shared pool.
+    std::vector<size_t>             mutated;        // rows in children
+    std::vector<size_t>             decoded;        // rows in children
+    std::vector<ConstChromosomeRef> decoded_genes;  // their chromosomes
+    mutated.reserve(capacity);
+    decoded.reserve(capacity);
+    decoded_genes.reserve(capacity);
+
+    // parent rows by fitness, and their fitness in that order, which the
+    // tournaments select from
+    std::vector<size_t>  order(capacity);
+    std::vector<Fitness> ranked_fitness(capacity);
+    Individual           immigrant;
+
+    auto rank_parents = [&]() {
+        const std::span<size_t> ranked(order.data(), num_parents);
+        std::iota(ranked.begin(), ranked.end(), 0);
+        std::ranges::sort(ranked, [&](size_t lhs, size_t rhs) {
+            return parents.fitness(lhs) < parents.fitness(rhs);
         });
+        return ranked;
+    };
+
+    // built once, the batches of every generation reuse it: the first
+    // tasks decode a SIMD batch of children each, the others mutate one
+    const size_t lanes       = batch_lanes(decode_isa_);
+    size_t       num_batches = 0;
+    const std::function<void(size_t)> evaluate_offspring = [&](size_t task) {
+        if (task >= num_batches) {
+            // keyed by row, the number of batches depends on the decode isa
+            const size_t             row = mutated[task - num_batches];
+            const ScopedThreadStream stream(
+                task_stream(generation_stream, row));
+            children.fitness(row) = mutation(children.chromosome(row),
+                                             instance,
+                                             decode_mode_,
+                                             decode_delay_);
+            return;
+        }
+        const size_t first = task * lanes;
+        const size_t size  = std::min(lanes, decoded.size() - first);
+        if (decode_mode_ != DecodeMode::SEMI_ACTIVE) {
+            // the SIMD batches only decode semi-active schedules
+            for (size_t i = first; i < first + size; ++i) {
+                children.fitness(decoded[i]) =
+                    evaluate(decoded_genes[i], instance);
+            }
+            return;
+        }
+        std::array<Fitness, MAX_BATCH_LANES> makespans{};
+        decode_makespan_batch(
+            std::span(decoded_genes).subspan(first, size),
+            instance,
+            std::span(makespans).first(size),
+            decode_isa_);
+        for (size_t i = 0; i < size; ++i) {
+            children.fitness(decoded[first + i]) = makespans[i];
+        }
+    };
 
+    for (int generation = 1; !stop.load(); ++generation) {
+        if (generation_limit_ > 0 && generation > generation_limit_) {
+            break;
+        }
+        generation_stream = task_stream(island_stream, generation);
+
+        // rank the parents by fitness
+        std::span<size_t> ranked = rank_parents();
+        if (receive_immigrants(parents, ranked, immigrant, island)) {
+            ranked = rank_parents();
+        }
 
         // check and update the global best solution
-        if (population[0].fitness <
-            get_gbest_fitnesss(global_best, gbest_mtx)) {
-            update_gbest(population[0], instance, gbest_mtx, global_best);
-            std::cout << "Current Best Fitness: " << population[0].fitness
-                      << '\n';
+        const size_t best = ranked[0];
+        if (parents.fitness(best) < incumbent.makespan()) {
+            update_gbest(parents.chromosome(best),
+                         parents.fitness(best),
+                         instance,
+                         incumbent);
         }
 
-        // check and update the local best solutions
-        if (population[0].fitness <
-            get_worst_pbest_fitness(pbests_, pbest_mtx_)) {
-            update_pbests(population[0], pbest_mtx_, pbests_);
+        if (migration_interval_ > 0 && generation % migration_interval_ == 0) {
+            send_emigrants(parents, ranked, island);
         }
 
 
-        Population new_gen;
-        new_gen.reserve(population_size_);
+        mutated.clear();
+        decoded.clear();
+        decoded_genes.clear();
+        size_t        num_children   = 0;
+        std::uint64_t num_crossovers = 0;
+        std::uint64_t num_mutations  = 0;
 
         // select the best 10 individuals directly into the new generation
-        for (int i = 0; i < 10; i++) {
-            new_gen.push_back(population[i]);
-        }
-
-        // remove the worst 10 individuals from population
-        for (int i = 0; i < 30; i++) {
-            population.pop_back();
+        const size_t num_elite = std::min<size_t>(10, num_parents);
+        for (; num_children < num_elite; ++num_children) {
+            children.copy(num_children, parents, ranked[num_children]);
         }
 
-        // copy the pbests to population, for crossover and mutation
-        for (const auto& pbest : pbests_) {
-            population.push_back(pbest);
+        // leave the worst 20 individuals (at most half of a small
+        // population) out of the parents of crossover and mutation
+        const size_t pool_size =
+            num_parents - std::min<size_t>(20, num_parents / 2);
+        for (size_t rank = 0; rank < pool_size; ++rank) {
+            ranked_fitness[rank] = parents.fitness(ranked[rank]);
         }
+        const std::span<const Fitness> pool(ranked_fitness.data(), pool_size);
 
-        while (new_gen.size() < population_size_) {
+        while (num_children < population_size_) {
 
             // select two parents using tournament selection
             std::uniform_real_distribution<float> proba_dist(0, 1);
 
             // mutation with 30% probability
             if (proba_dist(rand_engine) < 0.3) {
-                auto parent1 = tournament_selection(population);
-                mutation(parent1, instance);
-                new_gen.push_back(parent1);
+                ++num_mutations;
+                children.copy(
+                    num_children, parents, ranked[tournament_selection(pool)]);
+                mutated.push_back(num_children++);
                 continue;
             }
 
             // crossover with 70% probability
             if (proba_dist(rand_engine) < 0.7) {
-                auto       parent1 = tournament_selection(population);
-                auto       parent2 = tournament_selection(population);
-                Individual child1{};
-                Individual child2{};
-                // crossover the parents
-                auto [chromo1, chromo2] = crossover(parent1, parent2);
-                child1.chromosome       = chromo1;
-                child2.chromosome       = chromo2;
-
-                auto sol1      = decode(chromo1, instance);
-                auto sol2      = decode(chromo2, instance);
-                child1.fitness = sol1.makespan;
-                child2.fitness = sol2.makespan;
-
-                new_gen.push_back(child1);
-                new_gen.push_back(child2);
+                const size_t parent1 = ranked[tournament_selection(pool)];
+                const size_t parent2 = ranked[tournament_selection(pool)];
+                // crossover the parents into the next two rows
+                crossover(parents.chromosome(parent1),
+                          parents.chromosome(parent2),
+                          children.chromosome(num_children),
+                          children.chromosome(num_children + 1));
+
+                ++num_crossovers;
+                for (int child = 0; child < 2; ++child) {
+                    decoded.push_back(num_children);
+                    decoded_genes.push_back(children.chromosome(num_children));
+                    ++num_children;
+                }
                 continue;
             }
         }
-        population = std::move(new_gen);
-    }
-}
 
-Fitness GAAlgorithm::get_gbest_fitnesss(const Solution&    global_best,
-                                        std::shared_mutex& gbest_mtx)
-{
-    std::shared_lock<std::shared_mutex> lock(gbest_mtx);
-    return global_best.makespan;
-}
+        // evaluate the whole generation as one batch
+        num_batches = (decoded.size() + lanes - 1) / lanes;
+        parallel_for(num_batches + mutated.size(), evaluate_offspring, 2);
+        std::swap(parents, children);
+        num_parents = num_children;
 
+        count(Counter::GENERATIONS);
+        count(Counter::CROSSOVERS, num_crossovers);
+        count(Counter::MUTATIONS, num_mutations);
+    }
 
-Fitness GAAlgorithm::get_worst_pbest_fitness(
-    const std::vector<Individual>& pbests, std::shared_mutex& pbest_mtx)
-{
-    std::shared_lock<std::shared_mutex> lock(pbest_mtx);
-    if (pbests.empty()) {
-        return std::numeric_limits<Fitness>::max();
+    Population& population = populations_[island];
+    population.clear();
+    for (size_t i = 0; i < num_parents; ++i) {
+        population.push_back(parents.individual(i));
     }
-    return std::min_element(pbests.begin(),
-                            pbests.end(),
-                            [](const auto& lhs, const auto& rhs) {
-                                return lhs.fitness < rhs.fitness;
-                            })
-        ->fitness;
 }
 
-void GAAlgorithm::update_gbest(const Individual&      individual,
-                               const JobShopInstance& instance,
-                               std::shared_mutex&     gbest_mtx,
-                               Solution&              global_best)
+bool GAAlgorithm::receive_immigrants(PopulationArena&        population,
+                                     std::span<const size_t> ranked,
+                                     Individual& immigrant, int island)
 {
-    std::unique_lock<std::shared_mutex> lock(gbest_mtx);
-    if (individual.fitness < global_best.makespan) {
-        global_best = decode(individual.chromosome, instance);
+    size_t replaced = 0;
+    for (int from = 0; from < num_thread_; ++from) {
+        if (from == island) {
+            continue;
+        }
+        while (mailbox(from, island).try_pop(immigrant)) {
+            if (replaced < ranked.size() &&
+                immigrant.fitness <
+                    population.fitness(ranked[ranked.size() - 1 - replaced])) {
+                population.assign(ranked[ranked.size() - 1 - replaced],
+                                  immigrant);
+                ++replaced;
+            }
+        }
     }
+    return replaced > 0;
 }
 
-void GAAlgorithm::update_pbests(const Individual&        individual,
-                                std::shared_mutex&       pbest_mtx,
-                                std::vector<Individual>& pbests)
+void GAAlgorithm::send_emigrants(const PopulationArena&  population,
+                                 std::span<const size_t> ranked, int island)
 {
-    std::unique_lock<std::shared_mutex> lock(pbest_mtx);
-    if (pbests.size() < 10) {
-        pbests.push_back(individual);
+    if (num_thread_ < 2) {
+        return;
     }
-    else {
-        auto worst_pbest = std::max_element(
-            pbests.begin(), pbests.end(), [](const auto& lhs, const auto& rhs) {
-                return lhs.fitness < rhs.fitness;
-            });
-        if (individual.fitness < worst_pbest->fitness) {
-            *worst_pbest = individual;
+    int to = (island + 1) % num_thread_;
+    if (topology_ == Topology::RANDOM) {
+        std::uniform_int_distribution<int> dist(1, num_thread_ - 1);
+        to = (island + dist(thread_rng())) % num_thread_;
+    }
+    // a full mailbox drops the emigrants, the receiver is behind anyway
+    const size_t num_emigrants =
+        std::min<size_t>(migration_size_, ranked.size());
+    for (size_t i = 0; i < num_emigrants; ++i) {
+        if (!mailbox(island, to).try_push(population.individual(ranked[i]))) {
+            break;
         }
     }
 }
 
+void GAAlgorithm::update_gbest(ConstChromosomeRef      chromosome,
+                               Fitness                 fitness,
+                               const CompiledInstance& instance,
+                               Incumbent&              incumbent) const
+{
+    // the full solution is only decoded once the improvement is claimed
+    incumbent.try_publish(fitness, [&]() {
+        return decode(chromosome, instance, decode_mode_, decode_delay_);
+    });
+}
+
 
 }   // namespace scheduling
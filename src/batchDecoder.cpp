@@ -0,0 +1,302 @@
+#include "batchDecoder.hpp"
+#include "compiledInstance.hpp"
+#include "decoder.hpp"
+#include "telemetry.hpp"
+#include "types.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SCHEDULING_X86_KERNELS 1
+#endif
+
+
+namespace scheduling {
+
+namespace {
+
+// genes loaded and decoded at a time, so that the loaded block stays in L1
+constexpr size_t BLOCK_GENES = 128;
+
+// lane-interleaved state of one batch, one per thread
+struct BatchScratch
+{
+    std::vector<JobID>     jobs;          // [gene * lanes + lane], dense
+    std::vector<OpID>      ops;           // [gene * lanes + lane]
+    std::vector<TimeStamp> machine_end;   // [machine * lanes + lane]
+    std::vector<TimeStamp> job_end;       // [job * lanes + lane]
+    std::vector<OpID>      job_next_op;   // [job * lanes + lane]
+    std::array<TimeStamp, MAX_BATCH_LANES> makespans{};
+
+    // start a batch, the lanes past its end decode its first chromosome
+    void reset(std::span<const ConstChromosomeRef> batch,
+               const CompiledInstance& instance, size_t lanes)
+    {
+        batch_ = batch;
+        lanes_ = lanes;
+        jobs.resize(BLOCK_GENES * lanes);
+        ops.resize(BLOCK_GENES * lanes);
+        machine_end.assign(instance.num_machines() * lanes, 0);
+        job_end.assign(instance.num_jobs() * lanes, 0);
+        job_next_op.resize(instance.num_jobs() * lanes);
+        for (JobID job = 0; job < instance.num_jobs(); ++job) {
+            std::fill_n(job_next_op.begin() + job * lanes,
+                        lanes,
+                        instance.job_begin(job));
+        }
+        makespans.fill(0);
+    }
+
+    // Load genes [first, first + count) of every lane. The operation of a
+    // gene only depends on the genes before it, so it is resolved here and
+    // the kernels are left with the time arithmetic.
+    void load(const CompiledInstance& instance, size_t first, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i) {
+            for (size_t lane = 0; lane < lanes_; ++lane) {
+                const ConstChromosomeRef chromosome =
+                    batch_[lane < batch_.size() ? lane : 0];
+                const JobID job = instance.job_index(chromosome[first + i]);
+                jobs[i * lanes_ + lane] = job;
+                ops[i * lanes_ + lane]  = job_next_op[job * lanes_ + lane]++;
+            }
+        }
+    }
+
+private:
+    std::span<const ConstChromosomeRef> batch_;
+    size_t                              lanes_ = 0;
+};
+
+#if defined(SCHEDULING_X86_KERNELS)
+
+// One gene step of the 8 lanes: gather, max, add, then scatter the end
+// times with scalar stores (AVX2 has gathers but no scatter).
+__attribute__((target("avx2"))) void decode_avx2(
+    BatchScratch& scratch, const CompiledInstance& instance, size_t num_genes)
+{
+    constexpr size_t LANES = 8;
+
+    const auto* op_machines =
+        reinterpret_cast<const int*>(instance.op_machines().data());
+    const auto* op_durations =
+        reinterpret_cast<const int*>(instance.op_durations().data());
+    const auto* machine_end =
+        reinterpret_cast<const int*>(scratch.machine_end.data());
+    const auto* job_end = reinterpret_cast<const int*>(scratch.job_end.data());
+
+    const __m256i lane     = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    __m256i       makespan = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(scratch.makespans.data()));
+
+    alignas(32) std::array<std::uint32_t, LANES> job_slots{};
+    alignas(32) std::array<std::uint32_t, LANES> machine_slots{};
+    alignas(32) std::array<std::uint32_t, LANES> ends{};
+
+    for (size_t i = 0; i < num_genes; ++i) {
+        const __m256i job = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(&scratch.jobs[i * LANES]));
+        const __m256i op = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(&scratch.ops[i * LANES]));
+        const __m256i job_slot =
+            _mm256_add_epi32(_mm256_slli_epi32(job, 3), lane);
+
+        const __m256i machine = _mm256_i32gather_epi32(op_machines, op, 4);
+        const __m256i duration = _mm256_i32gather_epi32(op_durations, op, 4);
+        const __m256i machine_slot =
+            _mm256_add_epi32(_mm256_slli_epi32(machine, 3), lane);
+
+        const __m256i start = _mm256_max_epu32(
+            _mm256_i32gather_epi32(machine_end, machine_slot, 4),
+            _mm256_i32gather_epi32(job_end, job_slot, 4));
+        const __m256i end = _mm256_add_epi32(start, duration);
+        makespan          = _mm256_max_epu32(makespan, end);
+
+        _mm256_store_si256(reinterpret_cast<__m256i*>(job_slots.data()),
+                           job_slot);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(machine_slots.data()),
+                           machine_slot);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(ends.data()), end);
+        for (size_t l = 0; l < LANES; ++l) {
+            scratch.job_end[job_slots[l]]         = ends[l];
+            scratch.machine_end[machine_slots[l]] = ends[l];
+        }
+    }
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(scratch.makespans.data()),
+                        makespan);
+}
+
+// One gene step of the 16 lanes, with native scatters. The lanes of a
+// scatter never share a slot, the state is interleaved by lane.
+__attribute__((target("avx512f"))) void decode_avx512(
+    BatchScratch& scratch, const CompiledInstance& instance, size_t num_genes)
+{
+    constexpr size_t LANES = 16;
+
+    const auto* op_machines  = instance.op_machines().data();
+    const auto* op_durations = instance.op_durations().data();
+    auto*       machine_end  = scratch.machine_end.data();
+    auto*       job_end      = scratch.job_end.data();
+
+    const __m512i lane = _mm512_setr_epi32(
+        0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    __m512i makespan = _mm512_loadu_si512(scratch.makespans.data());
+
+    for (size_t i = 0; i < num_genes; ++i) {
+        const __m512i job = _mm512_loadu_si512(&scratch.jobs[i * LANES]);
+        const __m512i op  = _mm512_loadu_si512(&scratch.ops[i * LANES]);
+        const __m512i job_slot =
+            _mm512_add_epi32(_mm512_slli_epi32(job, 4), lane);
+
+        const __m512i machine = _mm512_i32gather_epi32(op, op_machines, 4);
+        const __m512i duration = _mm512_i32gather_epi32(op, op_durations, 4);
+        const __m512i machine_slot =
+            _mm512_add_epi32(_mm512_slli_epi32(machine, 4), lane);
+
+        const __m512i start = _mm512_max_epu32(
+            _mm512_i32gather_epi32(machine_slot, machine_end, 4),
+            _mm512_i32gather_epi32(job_slot, job_end, 4));
+        const __m512i end = _mm512_add_epi32(start, duration);
+        makespan          = _mm512_max_epu32(makespan, end);
+
+        _mm512_i32scatter_epi32(job_end, job_slot, end, 4);
+        _mm512_i32scatter_epi32(machine_end, machine_slot, end, 4);
+    }
+    _mm512_storeu_si512(scratch.makespans.data(), makespan);
+}
+
+#endif
+
+}   // namespace
+
+const char* decode_isa_name(DecodeIsa isa)
+{
+    switch (isa) {
+    case DecodeIsa::SCALAR: return "scalar";
+    case DecodeIsa::AVX2: return "avx2";
+    case DecodeIsa::AVX512: return "avx512";
+    default: return "unknown";
+    }
+}
+
+bool decode_isa_supported(DecodeIsa isa)
+{
+    switch (isa) {
+    case DecodeIsa::SCALAR: return true;
+#if defined(SCHEDULING_X86_KERNELS)
+    case DecodeIsa::AVX2: return __builtin_cpu_supports("avx2");
+    case DecodeIsa::AVX512: return __builtin_cpu_supports("avx512f");
+#endif
+    default: return false;
+    }
+}
+
+DecodeIsa decode_isa()
+{
+    static const DecodeIsa isa = []() {
+        for (DecodeIsa candidate : {DecodeIsa::AVX512, DecodeIsa::AVX2}) {
+            if (decode_isa_supported(candidate)) {
+                return candidate;
+            }
+        }
+        return DecodeIsa::SCALAR;
+    }();
+    return isa;
+}
+
+DecodeIsa fastest_decode_isa(const CompiledInstance& instance)
+{
+    using Clock = std::chrono::steady_clock;
+
+    // a fixed seed, the calibration must not consume the run's streams
+    std::mt19937            rng(instance.num_ops());
+    std::vector<Chromosome> population(2 * MAX_BATCH_LANES);
+    for (Chromosome& chromosome : population) {
+        for (JobID job = 0; job < instance.num_jobs(); ++job) {
+            chromosome.insert(chromosome.end(),
+                              instance.job_end(job) - instance.job_begin(job),
+                              instance.job_ids()[job]);
+        }
+        std::ranges::shuffle(chromosome, rng);
+    }
+    const std::vector<ConstChromosomeRef> chromosomes(population.begin(),
+                                                      population.end());
+    std::vector<Fitness> makespans(chromosomes.size());
+
+    DecodeIsa fastest      = DecodeIsa::SCALAR;
+    auto      fastest_time = Clock::duration::max();
+    for (DecodeIsa isa :
+         {DecodeIsa::SCALAR, DecodeIsa::AVX2, DecodeIsa::AVX512}) {
+        if (!decode_isa_supported(isa)) {
+            continue;
+        }
+        // best of a few runs, the first one also warms up the scratch
+        auto time = Clock::duration::max();
+        for (int run = 0; run < 3; ++run) {
+            const auto start = Clock::now();
+            decode_makespan_batch(chromosomes, instance, makespans, isa);
+            time = std::min(time, Clock::now() - start);
+        }
+        if (time < fastest_time) {
+            fastest      = isa;
+            fastest_time = time;
+        }
+    }
+    return fastest;
+}
+
+size_t batch_lanes(DecodeIsa isa)
+{
+    switch (isa) {
+    case DecodeIsa::AVX2: return 8;
+    case DecodeIsa::AVX512: return 16;
+    default: return 1;
+    }
+}
+
+void decode_makespan_batch(std::span<const ConstChromosomeRef> chromosomes,
+                           const CompiledInstance&             instance,
+                           std::span<Fitness> makespans, DecodeIsa isa)
+{
+#if defined(SCHEDULING_X86_KERNELS)
+    if (isa != DecodeIsa::SCALAR) {
+        thread_local BatchScratch scratch;
+        count(Counter::DECODES, chromosomes.size());
+
+        const size_t lanes     = batch_lanes(isa);
+        const size_t num_genes = instance.num_ops();
+        for (size_t first = 0; first < chromosomes.size(); first += lanes) {
+            const auto batch = chromosomes.subspan(
+                first, std::min(lanes, chromosomes.size() - first));
+            scratch.reset(batch, instance, lanes);
+            for (size_t gene = 0; gene < num_genes; gene += BLOCK_GENES) {
+                const size_t block = std::min(BLOCK_GENES, num_genes - gene);
+                scratch.load(instance, gene, block);
+                if (isa == DecodeIsa::AVX512) {
+                    decode_avx512(scratch, instance, block);
+                }
+                else {
+                    decode_avx2(scratch, instance, block);
+                }
+            }
+            std::copy_n(scratch.makespans.begin(),
+                        batch.size(),
+                        makespans.begin() + first);
+        }
+        return;
+    }
+#endif
+    for (size_t i = 0; i < chromosomes.size(); ++i) {
+        makespans[i] = decode_makespan(chromosomes[i], instance);
+    }
+}
+
+}   // namespace scheduling
@@ -0,0 +1,85 @@
+#include "compiledInstance.hpp"
+#include "decoder.hpp"
+#include "jobShopInstance.hpp"
+#include "types.hpp"
+
+#include <algorithm>
+#include <vector>
+
+
+namespace scheduling {
+
+CompiledInstance::CompiledInstance(const JobShopInstance& instance)
+{
+    const auto& jobs     = instance.jobs();
+    const auto& machines = instance.machines();
+
+    // dense machine ids, in the order of the original ids
+    machine_ids_.reserve(machines.size());
+    for (const auto& [machine_id, machine] : machines) {
+        if (machine_id >= machine_index_.size()) {
+            machine_index_.resize(machine_id + 1);
+        }
+        machine_index_[machine_id] = machine_ids_.size();
+        machine_ids_.push_back(machine_id);
+    }
+
+    // dense job ids and the per-operation arrays, steps in step order
+    job_ids_.reserve(jobs.size());
+    job_offsets_.reserve(jobs.size() + 1);
+    for (const auto& [job_id, job] : jobs) {
+        if (job_id >= job_index_.size()) {
+            job_index_.resize(job_id + 1);
+        }
+        const JobID job_index = job_ids_.size();
+        job_index_[job_id]    = job_index;
+        job_ids_.push_back(job_id);
+        job_offsets_.push_back(op_machines_.size());
+
+        TimeStamp job_length = 0;
+        for (const auto& [step_id, step] : job.steps) {
+            op_machines_.push_back(machine_index_[step.machine_id]);
+            op_durations_.push_back(step.duration);
+            op_jobs_.push_back(job_index);
+            op_steps_.push_back(step_id);
+            total_duration_ += step.duration;
+            job_length += step.duration;
+        }
+        lower_bound_ = std::max(lower_bound_, job_length);
+    }
+    job_offsets_.push_back(op_machines_.size());
+    if (!jobs.empty() && op_machines_.size() % jobs.size() == 0) {
+        ops_per_job_ = op_machines_.size() / jobs.size();
+        for (JobID job = 0; job < jobs.size(); ++job) {
+            if (job_offsets_[job + 1] - job_offsets_[job] != ops_per_job_) {
+                ops_per_job_ = 0;
+                break;
+            }
+        }
+    }
+
+    // per-machine operation lists (counting sort by machine, ops stay in
+    // job order within each machine)
+    machine_offsets_.assign(machine_ids_.size() + 1, 0);
+    std::vector<TimeStamp> machine_loads(machine_ids_.size(), 0);
+    for (OpID op = 0; op < op_machines_.size(); ++op) {
+        ++machine_offsets_[op_machines_[op] + 1];
+        machine_loads[op_machines_[op]] += op_durations_[op];
+    }
+    for (TimeStamp load : machine_loads) {
+        lower_bound_ = std::max(lower_bound_, load);
+    }
+    for (size_t machine = 0; machine < machine_ids_.size(); ++machine) {
+        machine_offsets_[machine + 1] += machine_offsets_[machine];
+    }
+    machine_op_list_.resize(op_machines_.size());
+    std::vector<OpID> fill(machine_offsets_.begin(),
+                           machine_offsets_.end() - 1);
+    for (OpID op = 0; op < op_machines_.size(); ++op) {
+        machine_op_list_[fill[op_machines_[op]]++] = op;
+    }
+
+    makespan_decoder_ = fixed_shape_decoder(*this);
+}
+
+}   // namespace scheduling
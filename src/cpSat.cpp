@@ -0,0 +1,157 @@
+#include "cpSat.hpp"
+#include "compiledInstance.hpp"
+#include "disjunctiveGraph.hpp"
+#include "incumbent.hpp"
+#include "random.hpp"
+#include "solution.hpp"
+#include "types.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "ortools/sat/cp_model.h"
+#include "ortools/sat/cp_model.pb.h"
+#include "ortools/sat/cp_model_solver.h"
+#include "ortools/sat/model.h"
+#include "ortools/sat/sat_parameters.pb.h"
+#include "ortools/util/time_limit.h"
+
+
+namespace scheduling {
+
+JobShopModel::JobShopModel(const CompiledInstance& instance, int64_t horizon)
+{
+    const auto durations = instance.op_durations();
+
+    starts.reserve(instance.num_ops());
+    intervals.reserve(instance.num_ops());
+    for (OpID op = 0; op < instance.num_ops(); ++op) {
+        starts.push_back(builder.NewIntVar({0, horizon - durations[op]}));
+        intervals.push_back(
+            builder.NewFixedSizeIntervalVar(starts.back(), durations[op]));
+    }
+
+    // job precedences and makespan
+    const int64_t lower_bound = instance.lower_bound();
+    makespan = builder.NewIntVar({std::min(lower_bound, horizon), horizon});
+    for (JobID job = 0; job < instance.num_jobs(); ++job) {
+        for (OpID op = instance.job_begin(job) + 1; op < instance.job_end(job);
+             ++op) {
+            builder.AddLessOrEqual(starts[op - 1] + durations[op - 1],
+                                   starts[op]);
+        }
+        if (instance.job_begin(job) < instance.job_end(job)) {
+            const OpID last = instance.job_end(job) - 1;
+            builder.AddLessOrEqual(starts[last] + durations[last], makespan);
+        }
+    }
+
+    // one operation at a time per machine
+    std::vector<sat::IntervalVar> machine_intervals;
+    for (MachineID machine = 0; machine < instance.num_machines(); ++machine) {
+        machine_intervals.clear();
+        for (OpID op : instance.machine_ops(machine)) {
+            machine_intervals.push_back(intervals[op]);
+        }
+        builder.AddNoOverlap(machine_intervals);
+    }
+}
+
+void JobShopModel::start_times(const sat::CpSolverResponse& response,
+                               std::vector<TimeStamp>&       start_times) const
+{
+    start_times.resize(starts.size());
+    for (OpID op = 0; op < starts.size(); ++op) {
+        start_times[op] = static_cast<TimeStamp>(
+            sat::SolutionIntegerValue(response, starts[op]));
+    }
+}
+
+void CpSatAlgorithm::solve(const CompiledInstance& instance,
+                           Incumbent&              incumbent)
+{
+    std::cout << "solve from cp-sat algorithm solve func" << '\n';
+
+    incumbent.raise_lower_bound(instance.lower_bound());
+    const auto snapshot = incumbent.snapshot();
+
+    // no schedule is longer than the incumbent, or than all ops in a row
+    const int64_t horizon = snapshot != nullptr ? snapshot->makespan
+                                                : instance.total_duration();
+
+    JobShopModel model(instance, horizon);
+    model.builder.Minimize(model.makespan);
+
+    // warm start from the incumbent schedule
+    if (snapshot != nullptr && !snapshot->empty()) {
+        const auto graph = DisjunctiveGraph::from_solution(*snapshot, instance);
+        for (OpID op = 0; op < instance.num_ops(); ++op) {
+            model.builder.AddHint(model.starts[op], graph.head(op));
+        }
+        model.builder.AddHint(model.makespan, graph.makespan());
+    }
+
+    sat::SatParameters parameters;
+    parameters.set_num_workers(num_thread_);
+    parameters.set_max_time_in_seconds(
+        std::chrono::duration<double>(time_limit_).count());
+    parameters.set_random_seed(static_cast<int32_t>(
+        RandomEngine::splitmix64(master_seed() + random_stream_)));
+
+    sat::Model sat_model;
+    sat_model.Add(sat::NewSatParameters(parameters));
+
+    // publish improving solutions, as the semi-active schedule of their
+    // machine sequences
+    std::vector<TimeStamp> start_times(instance.num_ops());
+    sat_model.Add(sat::NewFeasibleSolutionObserver(
+        [&](const sat::CpSolverResponse& response) {
+            incumbent.raise_lower_bound(static_cast<Fitness>(
+                std::ceil(response.best_objective_bound())));
+            if (static_cast<Fitness>(response.objective_value()) >=
+                incumbent.makespan()) {
+                return;
+            }
+            model.start_times(response, start_times);
+            const auto graph =
+                DisjunctiveGraph::from_start_times(start_times, instance);
+            incumbent.try_publish(graph.makespan(),
+                                  [&graph]() { return graph.to_solution(); });
+        }));
+
+    // stop CP-SAT when the gap is closed by another algorithm, or at the
+    // time limit
+    std::atomic<bool> stop{false};
+    std::atomic<bool> finished{false};
+    sat_model.GetOrCreate<operations_research::TimeLimit>()
+        ->RegisterExternalBooleanAsLimit(&stop);
+    std::thread watcher([this, &incumbent, &stop, &finished]() {
+        wait_for_time_limit(incumbent, &finished);
+        stop = true;
+    });
+
+    const sat::CpSolverResponse response =
+        sat::SolveCpModel(model.builder.Build(), &sat_model);
+    finished = true;
+    watcher.join();
+
+    if (response.status() == sat::CpSolverStatus::OPTIMAL) {
+        incumbent.raise_lower_bound(
+            static_cast<Fitness>(response.objective_value()));
+    }
+    else {
+        incumbent.raise_lower_bound(static_cast<Fitness>(
+            std::ceil(response.best_objective_bound())));
+    }
+    std::cout << "cp-sat status: "
+              << sat::CpSolverStatus_Name(response.status())
+              << ", lower bound: " << incumbent.lower_bound() << '\n';
+}
+
+}   // namespace scheduling
@@ -0,0 +1,552 @@
+#include "decoder.hpp"
+#include "compiledInstance.hpp"
+#include "telemetry.hpp"
+#include "types.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace scheduling {
+
+namespace {
+
+// scratch state of the decode loop, one per thread
+struct DecodeScratch
+{
+    std::vector<TimeStamp> machine_end;
+    std::vector<TimeStamp> job_end;
+    std::vector<OpID>      job_next_op;
+
+    void reset(const CompiledInstance& instance)
+    {
+        const auto job_offsets = instance.job_offsets();
+        machine_end.assign(instance.num_machines(), 0);
+        job_end.assign(instance.num_jobs(), 0);
+        job_next_op.assign(job_offsets.begin(), job_offsets.end() - 1);
+    }
+};
+
+// idle interval [begin, end) of a machine, before its last operation
+struct Gap
+{
+    TimeStamp begin;
+    TimeStamp end;
+};
+
+// scratch state of the active and Giffler-Thompson decodes, one per thread
+struct ScheduleScratch
+{
+    DecodeScratch                 times;
+    std::vector<std::vector<Gap>> gaps;       // per machine, by begin
+    std::vector<size_t>           priority;   // gene index of each op
+    std::vector<JobID>            open_jobs;  // jobs with ops left
+
+    void reset(const CompiledInstance& instance)
+    {
+        times.reset(instance);
+        gaps.resize(instance.num_machines());
+        for (auto& machine_gaps : gaps) {
+            machine_gaps.clear();
+        }
+    }
+};
+
+// Schedule the operation into the first gap of its machine it fits in,
+// after ready, or after the last operation of the machine. The gaps are
+// disjoint and sorted, so their ends are sorted too, and the first gap
+// that can hold the operation is found by binary search on the end.
+TimeStamp insert_into_gap(std::vector<Gap>& gaps, TimeStamp& machine_end,
+                          TimeStamp ready, TimePeriod duration)
+{
+    auto gap = std::ranges::lower_bound(
+        gaps, ready + duration, {}, [](const Gap& gap) { return gap.end; });
+    while (gap != gaps.end() && gap->begin + duration > gap->end) {
+        ++gap;
+    }
+
+    if (gap == gaps.end()) {
+        const TimeStamp start = std::max(machine_end, ready);
+        if (start > machine_end) {
+            gaps.push_back({machine_end, start});
+        }
+        machine_end = start + duration;
+        return start;
+    }
+
+    // split the gap around the operation, empty pieces are dropped
+    const TimeStamp start = std::max(gap->begin, ready);
+    const Gap       left{gap->begin, start};
+    const Gap       right{start + duration, gap->end};
+    if (left.begin < left.end && right.begin < right.end) {
+        *gap = right;
+        gaps.insert(gap, left);
+    }
+    else if (left.begin < left.end) {
+        *gap = left;
+    }
+    else if (right.begin < right.end) {
+        *gap = right;
+    }
+    else {
+        gaps.erase(gap);
+    }
+    return start;
+}
+
+Fitness decode_semi_active(ConstChromosomeRef      chromosome,
+                           const CompiledInstance& instance,
+                           DecodeScratch&          scratch,
+                           std::span<TimeStamp>    start_times)
+{
+    TimeStamp makespan = 0;
+    for (JobID gene : chromosome) {
+        const JobID     job     = instance.job_index(gene);
+        const OpID      op      = scratch.job_next_op[job]++;
+        const MachineID machine = instance.op_machines()[op];
+
+        const TimeStamp start_time =
+            std::max(scratch.machine_end[machine], scratch.job_end[job]);
+        const TimeStamp end_time = start_time + instance.op_durations()[op];
+
+        scratch.machine_end[machine] = end_time;
+        scratch.job_end[job]         = end_time;
+        makespan                     = std::max(makespan, end_time);
+        if (!start_times.empty()) {
+            start_times[op] = start_time;
+        }
+    }
+    return makespan;
+}
+
+Fitness decode_active(ConstChromosomeRef      chromosome,
+                      const CompiledInstance& instance,
+                      ScheduleScratch&        scratch,
+                      std::span<TimeStamp>    start_times)
+{
+    DecodeScratch& times    = scratch.times;
+    TimeStamp      makespan = 0;
+    for (JobID gene : chromosome) {
+        const JobID      job      = instance.job_index(gene);
+        const OpID       op       = times.job_next_op[job]++;
+        const MachineID  machine  = instance.op_machines()[op];
+        const TimePeriod duration = instance.op_durations()[op];
+
+        const TimeStamp start_time = insert_into_gap(scratch.gaps[machine],
+                                                     times.machine_end[machine],
+                                                     times.job_end[job],
+                                                     duration);
+        times.job_end[job] = start_time + duration;
+        makespan           = std::max(makespan, times.job_end[job]);
+        if (!start_times.empty()) {
+            start_times[op] = start_time;
+        }
+    }
+    return makespan;
+}
+
+Fitness decode_giffler_thompson(ConstChromosomeRef      chromosome,
+                                const CompiledInstance& instance,
+                                double delay, ScheduleScratch& scratch,
+                                std::span<TimeStamp> start_times)
+{
+    DecodeScratch& times        = scratch.times;
+    const auto     op_machines  = instance.op_machines();
+    const auto     op_durations = instance.op_durations();
+
+    // the priority of an operation is the index of its gene
+    scratch.priority.resize(instance.num_ops());
+    for (size_t i = 0; i < chromosome.size(); ++i) {
+        const JobID job = instance.job_index(chromosome[i]);
+        scratch.priority[times.job_next_op[job]++] = i;
+    }
+    times.reset(instance);
+
+    scratch.open_jobs.clear();
+    for (JobID job = 0; job < instance.num_jobs(); ++job) {
+        if (instance.job_begin(job) < instance.job_end(job)) {
+            scratch.open_jobs.push_back(job);
+        }
+    }
+
+    auto earliest_start = [&](JobID job) {
+        const OpID op = times.job_next_op[job];
+        return std::max(times.machine_end[op_machines[op]], times.job_end[job]);
+    };
+
+    TimeStamp makespan = 0;
+    while (!scratch.open_jobs.empty()) {
+        // the machine of the schedulable operation that can finish first
+        TimeStamp earliest_end = std::numeric_limits<TimeStamp>::max();
+        MachineID machine      = 0;
+        for (JobID job : scratch.open_jobs) {
+            const OpID      op  = times.job_next_op[job];
+            const TimeStamp end = earliest_start(job) + op_durations[op];
+            if (end < earliest_end) {
+                earliest_end = end;
+                machine      = op_machines[op];
+            }
+        }
+
+        // the operations of that machine that could start before it ends
+        // conflict with it; the window shrinks with the delay, down to the
+        // operations starting first
+        TimeStamp first_start = earliest_end;
+        for (JobID job : scratch.open_jobs) {
+            if (op_machines[times.job_next_op[job]] == machine) {
+                first_start = std::min(first_start, earliest_start(job));
+            }
+        }
+        const double window =
+            first_start + delay * (earliest_end - first_start);
+
+        auto conflicts = [&](JobID job) {
+            const TimeStamp start = earliest_start(job);
+            return op_machines[times.job_next_op[job]] == machine &&
+                   (start == first_start ||
+                    (start < earliest_end && start <= window));
+        };
+        auto priority = [&](JobID job) {
+            return scratch.priority[times.job_next_op[job]];
+        };
+
+        // schedule the conflicting operation first in gene order
+        const size_t num_open = scratch.open_jobs.size();
+        size_t       selected = num_open;
+        for (size_t i = 0; i < num_open; ++i) {
+            const JobID job = scratch.open_jobs[i];
+            if (conflicts(job) &&
+                (selected == num_open ||
+                 priority(job) < priority(scratch.open_jobs[selected]))) {
+                selected = i;
+            }
+        }
+
+        const JobID     job   = scratch.open_jobs[selected];
+        const OpID      op    = times.job_next_op[job]++;
+        const TimeStamp start = std::max(times.machine_end[machine],
+                                         times.job_end[job]);
+        const TimeStamp end   = start + op_durations[op];
+        times.machine_end[machine] = end;
+        times.job_end[job]         = end;
+        makespan                   = std::max(makespan, end);
+        if (!start_times.empty()) {
+            start_times[op] = start;
+        }
+        if (times.job_next_op[job] == instance.job_end(job)) {
+            scratch.open_jobs[selected] = scratch.open_jobs.back();
+            scratch.open_jobs.pop_back();
+        }
+    }
+    return makespan;
+}
+
+// the fixed-shape kernels keep up to this many jobs on the stack; the
+// largest Taillard instances have 100
+constexpr size_t MAX_FIXED_SHAPE_JOBS = 128;
+
+// Semi-active makespan decode of one instance shape, fixed at compile time.
+// Every job has OPS_PER_JOB operations, so the first operation of a job is
+// job * OPS_PER_JOB, and all of the state is in std::arrays on the stack
+// instead of the thread's heap scratch: nothing to look up or resize per
+// call, and the machine loops unroll.
+template<size_t NUM_MACHINES, size_t OPS_PER_JOB>
+Fitness decode_makespan_fixed(ConstChromosomeRef      chromosome,
+                              const CompiledInstance& instance)
+{
+    const size_t num_jobs = instance.num_jobs();
+
+    std::array<TimeStamp, NUM_MACHINES>         machine_end{};
+    std::array<TimeStamp, MAX_FIXED_SHAPE_JOBS> job_end;
+    std::array<OpID, MAX_FIXED_SHAPE_JOBS>      job_next_op;
+    for (JobID job = 0; job < num_jobs; ++job) {
+        job_end[job]     = 0;
+        job_next_op[job] = job * OPS_PER_JOB;
+    }
+
+    const MachineID*  op_machines  = instance.op_machines().data();
+    const TimePeriod* op_durations = instance.op_durations().data();
+    for (JobID gene : chromosome) {
+        const JobID     job     = instance.job_index(gene);
+        const OpID      op      = job_next_op[job]++;
+        TimeStamp&      machine = machine_end[op_machines[op]];
+        const TimeStamp end =
+            std::max(machine, job_end[job]) + op_durations[op];
+        machine      = end;
+        job_end[job] = end;
+    }
+    // the last operation on a machine ends last on it
+    return *std::ranges::max_element(machine_end);
+}
+
+// the shapes with a compile-time kernel: the common benchmark sizes, where
+// every job visits every machine, and 20 machines of 10 operations per job
+struct FixedShape
+{
+    size_t          num_machines;
+    size_t          ops_per_job;
+    MakespanDecoder decode;
+};
+constexpr std::array<FixedShape, 6> FIXED_SHAPES{{
+    {5, 5, &decode_makespan_fixed<5, 5>},
+    {6, 6, &decode_makespan_fixed<6, 6>},
+    {10, 10, &decode_makespan_fixed<10, 10>},
+    {15, 15, &decode_makespan_fixed<15, 15>},
+    {20, 10, &decode_makespan_fixed<20, 10>},
+    {20, 20, &decode_makespan_fixed<20, 20>},
+}};
+
+}   // namespace
+
+
+bool has_fixed_shape_decoder(const CompiledInstance& instance)
+{
+    return instance.makespan_decoder() != nullptr;
+}
+
+MakespanDecoder fixed_shape_decoder(const CompiledInstance& instance)
+{
+    for (const FixedShape& shape : FIXED_SHAPES) {
+        if (shape.num_machines == instance.num_machines() &&
+            shape.ops_per_job == instance.ops_per_job() &&
+            instance.num_jobs() <= MAX_FIXED_SHAPE_JOBS) {
+            return shape.decode;
+        }
+    }
+    return nullptr;
+}
+
+const char* decode_mode_name(DecodeMode mode)
+{
+    switch (mode) {
+    case DecodeMode::SEMI_ACTIVE: return "semi_active";
+    case DecodeMode::ACTIVE: return "active";
+    case DecodeMode::GIFFLER_THOMPSON: return "giffler_thompson";
+    default: return "unknown";
+    }
+}
+
+DecodeMode parse_decode_mode(std::string_view name)
+{
+    for (DecodeMode mode : {DecodeMode::SEMI_ACTIVE,
+                            DecodeMode::ACTIVE,
+                            DecodeMode::GIFFLER_THOMPSON}) {
+        if (name == decode_mode_name(mode)) {
+            return mode;
+        }
+    }
+    throw std::invalid_argument("unknown decode mode: " + std::string(name));
+}
+
+Fitness decode_schedule(ConstChromosomeRef      chromosome,
+                        const CompiledInstance& instance, DecodeMode mode,
+                        double delay, std::span<TimeStamp> start_times)
+{
+    if (mode == DecodeMode::SEMI_ACTIVE && start_times.empty()) {
+        return decode_makespan(chromosome, instance);
+    }
+
+    thread_local ScheduleScratch scratch;
+    scratch.reset(instance);
+    count(Counter::DECODES);
+
+    switch (mode) {
+    case DecodeMode::ACTIVE:
+        return decode_active(chromosome, instance, scratch, start_times);
+    case DecodeMode::GIFFLER_THOMPSON:
+        return decode_giffler_thompson(
+            chromosome, instance, std::clamp(delay, 0.0, 1.0), scratch,
+            start_times);
+    default:
+        return decode_semi_active(
+            chromosome, instance, scratch.times, start_times);
+    }
+}
+
+Fitness decode_makespan(ConstChromosomeRef      chromosome,
+                        const CompiledInstance& instance)
+{
+    if (const MakespanDecoder decode = instance.makespan_decoder()) {
+        count(Counter::DECODES);
+        return decode(chromosome, instance);
+    }
+    return decode_makespan_generic(chromosome, instance);
+}
+
+Fitness decode_makespan_generic(ConstChromosomeRef      chromosome,
+                                const CompiledInstance& instance)
+{
+    thread_local DecodeScratch scratch;
+    scratch.reset(instance);
+    count(Counter::DECODES);
+
+    const auto op_machines  = instance.op_machines();
+    const auto op_durations = instance.op_durations();
+
+    TimeStamp makespan = 0;
+    for (JobID gene : chromosome) {
+        const JobID     job     = instance.job_index(gene);
+        const OpID      op      = scratch.job_next_op[job]++;
+        const MachineID machine = op_machines[op];
+
+        const TimeStamp start_time =
+            std::max(scratch.machine_end[machine], scratch.job_end[job]);
+        const TimeStamp end_time = start_time + op_durations[op];
+
+        scratch.machine_end[machine] = end_time;
+        scratch.job_end[job]         = end_time;
+        makespan                     = std::max(makespan, end_time);
+    }
+    return makespan;
+}
+
+Fitness IncrementalDecoder::reset(ConstChromosomeRef      base,
+                                  const CompiledInstance& instance)
+{
+    instance_ = &instance;
+    count(Counter::DECODES);
+
+    const size_t num_machines = instance.num_machines();
+    const size_t num_jobs     = instance.num_jobs();
+    const size_t num_genes    = base.size();
+
+    // restoring a checkpoint copies num_machines + 2 * num_jobs values, so
+    // replaying about as many genes keeps both costs balanced
+    stride_ = interval_ > 0 ? interval_
+                            : std::max<size_t>(16, num_machines + num_jobs);
+    const size_t num_checkpoints = std::max<size_t>(
+        1, (num_genes + stride_ - 1) / stride_);
+
+    checkpoint_machine_end_.resize(num_checkpoints * num_machines);
+    checkpoint_job_end_.resize(num_checkpoints * num_jobs);
+    checkpoint_job_next_op_.resize(num_checkpoints * num_jobs);
+    checkpoint_prefix_max_.assign(num_checkpoints, 0);
+    checkpoint_suffix_max_.assign(num_checkpoints, 0);
+
+    const auto job_offsets = instance.job_offsets();
+    machine_end_.assign(num_machines, 0);
+    job_end_.assign(num_jobs, 0);
+    job_next_op_.assign(job_offsets.begin(), job_offsets.end() - 1);
+
+    // forward pass: save the checkpoints, and the max end time of each block
+    TimeStamp running_max = 0;
+    for (size_t i = 0; i < num_genes; ++i) {
+        const size_t checkpoint = i / stride_;
+        if (i % stride_ == 0) {
+            save_checkpoint(checkpoint);
+            checkpoint_prefix_max_[checkpoint] = running_max;
+        }
+        const TimeStamp end_time = advance(base[i]);
+        running_max              = std::max(running_max, end_time);
+        checkpoint_suffix_max_[checkpoint] =
+            std::max(checkpoint_suffix_max_[checkpoint], end_time);
+    }
+    if (num_genes == 0) {
+        save_checkpoint(0);
+    }
+
+    // backward pass: block max -> suffix max
+    for (size_t k = num_checkpoints - 1; k > 0; --k) {
+        checkpoint_suffix_max_[k - 1] =
+            std::max(checkpoint_suffix_max_[k - 1], checkpoint_suffix_max_[k]);
+    }
+
+    makespan_ = running_max;
+    return makespan_;
+}
+
+Fitness IncrementalDecoder::evaluate(ConstChromosomeRef candidate,
+                                     size_t first_changed, size_t last_changed,
+                                     Fitness cutoff)
+{
+    assert(first_changed <= last_changed && last_changed < candidate.size());
+    count(Counter::DECODES);
+    const size_t checkpoint = first_changed / stride_;
+    restore_checkpoint(checkpoint);
+
+    TimeStamp running_max = checkpoint_prefix_max_[checkpoint];
+    for (size_t i = checkpoint * stride_; i < candidate.size(); ++i) {
+        // past the changed genes, the schedule converges back to the base one
+        // as soon as the state matches a base checkpoint
+        if (i > last_changed && i % stride_ == 0 &&
+            same_as_checkpoint(i / stride_)) {
+            return std::max(running_max, checkpoint_suffix_max_[i / stride_]);
+        }
+
+        running_max = std::max(running_max, advance(candidate[i]));
+        if (running_max >= cutoff) {
+            return running_max;
+        }
+    }
+    return running_max;
+}
+
+inline TimeStamp IncrementalDecoder::advance(JobID gene)
+{
+    const JobID     job     = instance_->job_index(gene);
+    const OpID      op      = job_next_op_[job]++;
+    const MachineID machine = instance_->op_machines()[op];
+
+    const TimeStamp start_time = std::max(machine_end_[machine], job_end_[job]);
+    const TimeStamp end_time   = start_time + instance_->op_durations()[op];
+
+    machine_end_[machine] = end_time;
+    job_end_[job]         = end_time;
+    return end_time;
+}
+
+void IncrementalDecoder::save_checkpoint(size_t checkpoint)
+{
+    const size_t num_machines = machine_end_.size();
+    const size_t num_jobs     = job_end_.size();
+
+    std::ranges::copy(machine_end_,
+                      checkpoint_machine_end_.begin() +
+                          checkpoint * num_machines);
+    std::ranges::copy(job_end_,
+                      checkpoint_job_end_.begin() + checkpoint * num_jobs);
+    std::ranges::copy(job_next_op_,
+                      checkpoint_job_next_op_.begin() + checkpoint * num_jobs);
+}
+
+void IncrementalDecoder::restore_checkpoint(size_t checkpoint)
+{
+    const size_t num_machines = machine_end_.size();
+    const size_t num_jobs     = job_end_.size();
+
+    auto machine_begin =
+        checkpoint_machine_end_.begin() + checkpoint * num_machines;
+    auto job_begin = checkpoint_job_end_.begin() + checkpoint * num_jobs;
+    auto next_op_begin =
+        checkpoint_job_next_op_.begin() + checkpoint * num_jobs;
+
+    std::copy_n(machine_begin, num_machines, machine_end_.begin());
+    std::copy_n(job_begin, num_jobs, job_end_.begin());
+    std::copy_n(next_op_begin, num_jobs, job_next_op_.begin());
+}
+
+bool IncrementalDecoder::same_as_checkpoint(size_t checkpoint) const
+{
+    // after the changed genes each job has consumed the same number of
+    // operations as in the base, so only the end times need comparing
+    const size_t num_machines = machine_end_.size();
+    const size_t num_jobs     = job_end_.size();
+
+    auto machine_begin =
+        checkpoint_machine_end_.begin() + checkpoint * num_machines;
+    auto job_begin = checkpoint_job_end_.begin() + checkpoint * num_jobs;
+
+    return std::equal(
+               machine_end_.begin(), machine_end_.end(), machine_begin) &&
+           std::equal(job_end_.begin(), job_end_.end(), job_begin);
+}
+
+}   // namespace scheduling
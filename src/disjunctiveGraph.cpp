@@ -0,0 +1,291 @@
+#include "disjunctiveGraph.hpp"
+#include "compiledInstance.hpp"
+#include "solution.hpp"
+#include "types.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+
+namespace scheduling {
+
+DisjunctiveGraph::DisjunctiveGraph(const CompiledInstance& instance)
+    : instance_(&instance)
+{
+    const size_t num_ops = instance.num_ops();
+
+    job_pred_.assign(num_ops, NONE);
+    job_succ_.assign(num_ops, NONE);
+    for (JobID job = 0; job < instance.num_jobs(); ++job) {
+        for (OpID op = instance.job_begin(job) + 1; op < instance.job_end(job);
+             ++op) {
+            job_pred_[op]     = op - 1;
+            job_succ_[op - 1] = op;
+        }
+    }
+
+    machine_pred_.assign(num_ops, NONE);
+    machine_succ_.assign(num_ops, NONE);
+    machine_sequence_.resize(num_ops);
+    machine_position_.resize(num_ops);
+    for (MachineID machine = 0; machine < instance.num_machines(); ++machine) {
+        set_machine_sequence(machine, instance.machine_ops(machine));
+    }
+
+    heads_.assign(num_ops, 0);
+    tails_.assign(num_ops, 0);
+    topo_order_.reserve(num_ops);
+    in_degree_.resize(num_ops);
+}
+
+DisjunctiveGraph DisjunctiveGraph::from_chromosome(
+    const Chromosome& chromosome, const CompiledInstance& instance)
+{
+    DisjunctiveGraph graph(instance);
+
+    // operations enter their machine sequence in chromosome order, the same
+    // way the semi-active decoder appends them
+    std::vector<OpID> job_next_op(instance.job_offsets().begin(),
+                                  instance.job_offsets().end() - 1);
+    std::vector<OpID> machine_fill(instance.machine_offsets().begin(),
+                                   instance.machine_offsets().end() - 1);
+    for (JobID gene : chromosome) {
+        const OpID op = job_next_op[instance.job_index(gene)]++;
+        graph.machine_sequence_[machine_fill[instance.op_machines()[op]]++] =
+            op;
+    }
+    for (MachineID machine = 0; machine < instance.num_machines(); ++machine) {
+        graph.link_machine(machine, 0, graph.machine_sequence(machine).size());
+    }
+
+    graph.update();
+    return graph;
+}
+
+DisjunctiveGraph DisjunctiveGraph::from_solution(
+    const Solution& solution, const CompiledInstance& instance)
+{
+    // the solution keeps its machine sequences in the same layout
+    DisjunctiveGraph graph(instance);
+    graph.machine_sequence_ = solution.machine_sequences;
+    for (MachineID machine = 0; machine < instance.num_machines(); ++machine) {
+        graph.link_machine(machine, 0, graph.machine_sequence(machine).size());
+    }
+
+    graph.update();
+    return graph;
+}
+
+DisjunctiveGraph DisjunctiveGraph::from_start_times(
+    std::span<const TimeStamp> start_times, const CompiledInstance& instance)
+{
+    DisjunctiveGraph graph(instance);
+
+    // machine sequences in start time order
+    std::vector<OpID> ops;
+    for (MachineID machine = 0; machine < instance.num_machines(); ++machine) {
+        auto machine_ops = instance.machine_ops(machine);
+        ops.assign(machine_ops.begin(), machine_ops.end());
+        std::ranges::stable_sort(ops, [&](OpID lhs, OpID rhs) {
+            return start_times[lhs] < start_times[rhs];
+        });
+        graph.set_machine_sequence(machine, ops);
+    }
+
+    graph.update();
+    return graph;
+}
+
+Solution DisjunctiveGraph::to_solution() const
+{
+    Solution solution(*instance_);
+
+    solution.start_times = heads_;
+    for (OpID op = 0; op < num_ops(); ++op) {
+        solution.end_times[op] = heads_[op] + duration(op);
+    }
+    solution.machine_sequences = machine_sequence_;
+
+    solution.makespan = makespan_;
+    solution.chromo   = to_chromosome();
+    return solution;
+}
+
+Chromosome DisjunctiveGraph::to_chromosome() const
+{
+    // sort by head, ties in topological order
+    std::vector<OpID> ops(topo_order_);
+    std::ranges::stable_sort(
+        ops, [&](OpID lhs, OpID rhs) { return heads_[lhs] < heads_[rhs]; });
+
+    Chromosome chromosome;
+    chromosome.reserve(ops.size());
+    for (OpID op : ops) {
+        chromosome.push_back(instance_->job_ids()[instance_->op_jobs()[op]]);
+    }
+    return chromosome;
+}
+
+std::span<const OpID> DisjunctiveGraph::machine_sequence(
+    MachineID machine) const
+{
+    const auto offsets = instance_->machine_offsets();
+    return std::span<const OpID>(machine_sequence_)
+        .subspan(offsets[machine], offsets[machine + 1] - offsets[machine]);
+}
+
+void DisjunctiveGraph::set_machine_sequence(MachineID             machine,
+                                            std::span<const OpID> ops)
+{
+    std::ranges::copy(
+        ops, machine_sequence_.begin() + instance_->machine_offsets()[machine]);
+    link_machine(machine, 0, ops.size());
+}
+
+void DisjunctiveGraph::move_on_machine(MachineID machine, size_t from,
+                                       size_t to)
+{
+    auto sequence = machine_sequence_.begin() +
+                    instance_->machine_offsets()[machine];
+    if (from < to) {
+        std::rotate(sequence + from, sequence + from + 1, sequence + to + 1);
+        link_machine(machine, from, to + 1);
+    }
+    else if (to < from) {
+        std::rotate(sequence + to, sequence + from, sequence + from + 1);
+        link_machine(machine, to, from + 1);
+    }
+}
+
+void DisjunctiveGraph::link_machine(MachineID machine, size_t begin,
+                                    size_t end)
+{
+    // relink positions [begin, end) and the arcs to their outer neighbors
+    const auto sequence = machine_sequence(machine);
+    for (size_t pos = begin; pos < end; ++pos) {
+        const OpID op         = sequence[pos];
+        machine_position_[op] = pos;
+        machine_pred_[op]     = pos > 0 ? sequence[pos - 1] : NONE;
+        machine_succ_[op] =
+            pos + 1 < sequence.size() ? sequence[pos + 1] : NONE;
+    }
+    if (begin > 0 && begin < end) {
+        machine_succ_[sequence[begin - 1]] = sequence[begin];
+    }
+    if (end < sequence.size() && begin < end) {
+        machine_pred_[sequence[end]] = sequence[end - 1];
+    }
+}
+
+bool DisjunctiveGraph::update()
+{
+    const size_t num_ops   = this->num_ops();
+    const auto   durations = instance_->op_durations();
+
+    // Kahn's algorithm, every node has at most two predecessors
+    topo_order_.clear();
+    for (OpID op = 0; op < num_ops; ++op) {
+        in_degree_[op] = (job_pred_[op] != NONE) + (machine_pred_[op] != NONE);
+        if (in_degree_[op] == 0) {
+            topo_order_.push_back(op);
+        }
+    }
+    for (size_t i = 0; i < topo_order_.size(); ++i) {
+        const OpID op = topo_order_[i];
+        for (OpID succ : {job_succ_[op], machine_succ_[op]}) {
+            if (succ != NONE && --in_degree_[succ] == 0) {
+                topo_order_.push_back(succ);
+            }
+        }
+    }
+    if (topo_order_.size() != num_ops) {
+        return false;
+    }
+
+    // heads forward, tails backward
+    makespan_ = 0;
+    for (OpID op : topo_order_) {
+        TimeStamp head = 0;
+        if (OpID pred = job_pred_[op]; pred != NONE) {
+            head = heads_[pred] + durations[pred];
+        }
+        if (OpID pred = machine_pred_[op]; pred != NONE) {
+            head = std::max(head, heads_[pred] + durations[pred]);
+        }
+        heads_[op] = head;
+        makespan_  = std::max(makespan_, head + durations[op]);
+    }
+    for (auto it = topo_order_.rbegin(); it != topo_order_.rend(); ++it) {
+        const OpID op   = *it;
+        TimeStamp  tail = 0;
+        if (OpID succ = job_succ_[op]; succ != NONE) {
+            tail = durations[succ] + tails_[succ];
+        }
+        if (OpID succ = machine_succ_[op]; succ != NONE) {
+            tail = std::max(tail, durations[succ] + tails_[succ]);
+        }
+        tails_[op] = tail;
+    }
+    return true;
+}
+
+std::vector<OpID> DisjunctiveGraph::critical_path() const
+{
+    std::vector<OpID> path;
+    if (num_ops() == 0) {
+        return path;
+    }
+
+    // start from a critical operation with head 0 and follow successors
+    // that keep the path critical, preferring machine arcs so that blocks
+    // stay together
+    OpID op = NONE;
+    for (OpID candidate : topo_order_) {
+        if (heads_[candidate] == 0 &&
+            duration(candidate) + tails_[candidate] == makespan_) {
+            op = candidate;
+            break;
+        }
+    }
+    while (op != NONE) {
+        path.push_back(op);
+        const TimeStamp end_time = heads_[op] + duration(op);
+        OpID            next     = NONE;
+        for (OpID succ : {machine_succ_[op], job_succ_[op]}) {
+            if (succ != NONE && heads_[succ] == end_time &&
+                end_time + duration(succ) + tails_[succ] == makespan_) {
+                next = succ;
+                break;
+            }
+        }
+        op = next;
+    }
+    return path;
+}
+
+std::vector<DisjunctiveGraph::CriticalBlock> DisjunctiveGraph::critical_blocks()
+    const
+{
+    std::vector<CriticalBlock> blocks;
+    const auto                 path = critical_path();
+    const auto                 op_machines = instance_->op_machines();
+
+    for (size_t i = 0; i < path.size();) {
+        // extend the block while the next path arc is a machine arc
+        size_t j = i + 1;
+        while (j < path.size() && machine_succ_[path[j - 1]] == path[j]) {
+            ++j;
+        }
+        blocks.push_back({op_machines[path[i]],
+                          machine_position_[path[i]],
+                          machine_position_[path[j - 1]] + 1});
+        i = j;
+    }
+    return blocks;
+}
+
+}   // namespace scheduling
@@ -0,0 +1,191 @@
+#include "grasp.hpp"
+#include "compiledInstance.hpp"
+#include "disjunctiveGraph.hpp"
+#include "incumbent.hpp"
+#include "random.hpp"
+#include "solution.hpp"
+#include "solutionConstructor.hpp"
+#include "tabuSearch.hpp"
+#include "telemetry.hpp"
+#include "threadPool.hpp"
+#include "types.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+
+namespace scheduling {
+
+void GraspAlgorithm::solve(const CompiledInstance& instance,
+                           Incumbent&              incumbent)
+{
+    std::cout << "solve from grasp algorithm solve func" << '\n';
+
+    // without the shared pool, the starts run on threads of their own
+    std::unique_ptr<ThreadPool> own_pool;
+    ThreadPool*                 pool = pool_;
+    if (pool == nullptr) {
+        own_pool = std::make_unique<ThreadPool>(num_thread_);
+        pool     = own_pool.get();
+    }
+
+    // the rounds of starts run until the last start or the time limit
+    const auto deadline = std::chrono::steady_clock::now() + time_limit_;
+    auto       stopped  = [&]() {
+        return incumbent.gap_closed() ||
+               std::chrono::steady_clock::now() >= deadline;
+    };
+    const std::uint64_t stream = worker_stream(0);
+    for (size_t first = 0;
+         (num_starts_ == 0 || first < num_starts_) && !stopped();
+         first += STARTS_PER_ROUND) {
+        const size_t round_size =
+            num_starts_ == 0 ? STARTS_PER_ROUND
+                             : std::min(STARTS_PER_ROUND, num_starts_ - first);
+        const AlphaWeights weights = alpha_weights();
+        pool->parallel_for(round_size, [&](size_t i) {
+            if (stopped()) {
+                return;
+            }
+            const ScopedThreadStream start_stream(
+                task_stream(stream, first + i));
+            construct(instance, incumbent, weights);
+        });
+    }
+}
+
+Population GraspAlgorithm::elite() const
+{
+    std::unique_lock lock(elite_mtx_, std::defer_lock);
+    timed_lock(lock);
+    return elite_;
+}
+
+void GraspAlgorithm::local_search(DisjunctiveGraph& graph)
+{
+    thread_local std::vector<TabuSearchAlgorithm::Move> moves;
+
+    bool improved = true;
+    while (improved) {
+        improved = false;
+        TabuSearchAlgorithm::generate_moves(
+            graph, TabuSearchAlgorithm::Neighborhood::N5, moves);
+        std::ranges::sort(moves, [](const auto& lhs, const auto& rhs) {
+            return lhs.estimate < rhs.estimate;
+        });
+
+        const TimeStamp makespan = graph.makespan();
+        for (const auto& move : moves) {
+            if (move.estimate >= makespan) {
+                break;
+            }
+            graph.move_on_machine(move.machine, move.from, move.to);
+            if (graph.update() && graph.makespan() < makespan) {
+                improved = true;
+                break;
+            }
+            graph.move_on_machine(move.machine, move.to, move.from);
+            graph.update();
+        }
+    }
+}
+
+void GraspAlgorithm::construct(const CompiledInstance& instance,
+                               Incumbent&              incumbent,
+                               const AlphaWeights&     weights)
+{
+    thread_local SolutionConstructor    constructor;
+    thread_local std::vector<TimeStamp> start_times;
+    constructor.convert_from_instance(instance);
+
+    count(Counter::ITERATIONS);
+    const size_t alpha = pick_alpha(weights, thread_rng());
+    constructor.set_alpha(ALPHAS[alpha]);
+    constructor.schedule(start_times);
+
+    auto graph = DisjunctiveGraph::from_start_times(start_times, instance);
+    local_search(graph);
+    const Fitness makespan = graph.makespan();
+
+    alpha_stats_[alpha].makespan_sum.fetch_add(makespan,
+                                               std::memory_order_relaxed);
+    alpha_stats_[alpha].count.fetch_add(1, std::memory_order_relaxed);
+    Fitness best = best_makespan_.load(std::memory_order_relaxed);
+    while (makespan < best &&
+           !best_makespan_.compare_exchange_weak(best, makespan)) {
+    }
+
+    incumbent.try_publish(makespan,
+                          [&graph]() { return graph.to_solution(); });
+    add_elite({graph.to_chromosome(), makespan});
+}
+
+GraspAlgorithm::AlphaWeights GraspAlgorithm::alpha_weights() const
+{
+    // untried alphas count as good as the best, to get tried
+    const double best    = best_makespan_.load(std::memory_order_relaxed);
+    AlphaWeights weights{};
+    for (size_t i = 0; i < ALPHAS.size(); ++i) {
+        const auto count =
+            alpha_stats_[i].count.load(std::memory_order_relaxed);
+        if (count == 0) {
+            weights[i] = 1.0;
+            continue;
+        }
+        const double average =
+            static_cast<double>(
+                alpha_stats_[i].makespan_sum.load(std::memory_order_relaxed)) /
+            count;
+        weights[i] = std::pow(best / average, 10.0);
+    }
+    return weights;
+}
+
+size_t GraspAlgorithm::pick_alpha(const AlphaWeights& weights,
+                                  RandomEngine&       rng) const
+{
+    if (!reactive_alpha_) {
+        return std::uniform_int_distribution<size_t>(0, ALPHAS.size() - 1)(
+            rng);
+    }
+    return std::discrete_distribution<size_t>(weights.begin(),
+                                              weights.end())(rng);
+}
+
+void GraspAlgorithm::add_elite(Individual individual)
+{
+    // ordered by fitness, then chromosome, so the elite does not depend on
+    // the order the starts finish in
+    auto better = [](const Individual& lhs, const Individual& rhs) {
+        return std::tie(lhs.fitness, lhs.chromosome) <
+               std::tie(rhs.fitness, rhs.chromosome);
+    };
+
+    std::unique_lock lock(elite_mtx_, std::defer_lock);
+    timed_lock(lock);
+    if (elite_size_ == 0 ||
+        (elite_.size() == elite_size_ && !better(individual, elite_.back()))) {
+        return;
+    }
+    auto position = std::ranges::lower_bound(elite_, individual, better);
+    if (position != elite_.end() && !better(individual, *position)) {
+        return;   // duplicate
+    }
+    elite_.insert(position, std::move(individual));
+    if (elite_.size() > elite_size_) {
+        elite_.pop_back();
+    }
+}
+
+}   // namespace scheduling
@@ -0,0 +1,101 @@
+#include "incumbent.hpp"
+#include "solution.hpp"
+#include "telemetry.hpp"
+#include "types.hpp"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <utility>
+
+
+namespace scheduling {
+
+Incumbent::Snapshot Incumbent::snapshot() const
+{
+#if defined(__cpp_lib_atomic_shared_ptr)
+    return snapshot_.load(std::memory_order_acquire);
+#else
+    return std::atomic_load_explicit(&snapshot_, std::memory_order_acquire);
+#endif
+}
+
+bool Incumbent::try_publish(Fitness                         makespan,
+                            const std::function<Solution()>& build)
+{
+    if (!claim(makespan)) {
+        return false;
+    }
+    if (observer_) {
+        observer_(makespan);
+    }
+    install(std::make_shared<const Solution>(build()));
+    return true;
+}
+
+bool Incumbent::publish(Solution solution)
+{
+    const Fitness makespan = solution.makespan;
+    if (!claim(makespan)) {
+        return false;
+    }
+    if (observer_) {
+        observer_(makespan);
+    }
+    install(std::make_shared<const Solution>(std::move(solution)));
+    return true;
+}
+
+bool Incumbent::raise_lower_bound(Fitness bound)
+{
+    Fitness current = lower_bound_.load(std::memory_order_relaxed);
+    while (bound > current) {
+        if (lower_bound_.compare_exchange_weak(
+                current, bound, std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool Incumbent::claim(Fitness makespan)
+{
+    Fitness best = best_makespan_.load(std::memory_order_relaxed);
+    while (makespan < best) {
+        if (best_makespan_.compare_exchange_weak(
+                best, makespan, std::memory_order_acq_rel)) {
+            count(Counter::IMPROVEMENTS);
+            return true;
+        }
+    }
+    return false;
+}
+
+void Incumbent::install(const Snapshot& snapshot)
+{
+    // two claimed improvements may install out of order, keep the better one
+    Snapshot current = this->snapshot();
+    while (current == nullptr || snapshot->makespan < current->makespan) {
+        if (compare_exchange(current, snapshot)) {
+            epoch_.fetch_add(1, std::memory_order_acq_rel);
+            return;
+        }
+    }
+}
+
+bool Incumbent::compare_exchange(Snapshot& expected, const Snapshot& desired)
+{
+#if defined(__cpp_lib_atomic_shared_ptr)
+    return snapshot_.compare_exchange_weak(
+        expected, desired, std::memory_order_acq_rel);
+#else
+    return std::atomic_compare_exchange_weak_explicit(
+        &snapshot_,
+        &expected,
+        desired,
+        std::memory_order_acq_rel,
+        std::memory_order_acquire);
+#endif
+}
+
+}   // namespace scheduling
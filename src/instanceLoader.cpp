@@ -0,0 +1,510 @@
+#include "instanceLoader.hpp"
+#include "jobShopInstance.hpp"
+#include "types.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+namespace scheduling {
+
+namespace {
+
+[[noreturn]] void fail(std::string_view text, const char* position,
+                       const std::string& what)
+{
+    throw std::runtime_error(what + " at offset " +
+                             std::to_string(position - text.data()));
+}
+
+bool is_space(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+// whitespace separated unsigned integers, read in place
+class NumberReader
+{
+public:
+    NumberReader(std::string_view text, const char* position)
+        : text_(text)
+        , position_(position)
+    {}
+
+    unsigned int next(const char* what)
+    {
+        const char* end = text_.data() + text_.size();
+        while (position_ != end && is_space(*position_)) {
+            ++position_;
+        }
+        unsigned int value  = 0;
+        auto [next, error] = std::from_chars(position_, end, value);
+        if (error != std::errc{}) {
+            fail(text_, position_, std::string("expected ") + what);
+        }
+        position_ = next;
+        return value;
+    }
+
+    size_t offset() const { return position_ - text_.data(); }
+
+private:
+    std::string_view text_;
+    const char*      position_;
+};
+
+// the line starting at position, and the position after it
+std::pair<std::string_view, const char*> next_line(std::string_view text,
+                                                    const char*      position)
+{
+    const char* end     = text.data() + text.size();
+    const char* newline = std::find(position, end, '\n');
+    return {std::string_view(position, newline - position),
+            newline == end ? end : newline + 1};
+}
+
+// the line holds exactly two unsigned integers
+bool parse_pair(std::string_view line, unsigned int& first,
+                unsigned int& second)
+{
+    const char* position = line.data();
+    const char* end      = line.data() + line.size();
+    for (unsigned int* value : {&first, &second}) {
+        while (position != end && is_space(*position)) {
+            ++position;
+        }
+        auto [next, error] = std::from_chars(position, end, *value);
+        if (error != std::errc{}) {
+            return false;
+        }
+        position = next;
+    }
+    while (position != end && is_space(*position)) {
+        ++position;
+    }
+    return position == end;
+}
+
+// number of whitespace separated tokens in text
+size_t count_tokens(std::string_view text)
+{
+    size_t count    = 0;
+    bool   in_token = false;
+    for (char c : text) {
+        count += !in_token && !is_space(c);
+        in_token = !is_space(c);
+    }
+    return count;
+}
+
+// number of operations of a "jobs machines" header, checked against the
+// tokens_per_op tokens of each operation that follow the header, so that a
+// bad header throws instead of sizing the instance past the file
+size_t num_header_ops(std::string_view rest, unsigned int num_jobs,
+                      unsigned int num_machines, size_t tokens_per_op)
+{
+    if (num_jobs == 0 || num_machines == 0) {
+        throw std::runtime_error("empty \"jobs machines\" header");
+    }
+    constexpr size_t max_size = std::numeric_limits<size_t>::max();
+    if (num_jobs > max_size / num_machines / tokens_per_op) {
+        throw std::runtime_error("\"jobs machines\" header too large");
+    }
+    const size_t num_ops = static_cast<size_t>(num_jobs) * num_machines;
+    if (num_ops * tokens_per_op > count_tokens(rest)) {
+        throw std::runtime_error(
+            "header of " + std::to_string(num_jobs) + " jobs and " +
+            std::to_string(num_machines) + " machines exceeds the file");
+    }
+    return num_ops;
+}
+
+void build_instance(unsigned int num_jobs, unsigned int num_machines,
+                    const std::vector<unsigned int>& machines,
+                    const std::vector<unsigned int>& durations,
+                    JobShopInstance&                 instance)
+{
+    instance.clear();
+    for (MachineID machine = 0; machine < num_machines; ++machine) {
+        instance.add_machine(machine);
+    }
+    for (JobID job = 0; job < num_jobs; ++job) {
+        instance.add_job(job, 0);
+        for (StepID step = 0; step < num_machines; ++step) {
+            instance.add_step(job,
+                              step,
+                              machines[size_t{job} * num_machines + step],
+                              durations[size_t{job} * num_machines + step]);
+        }
+    }
+}
+
+// Minimal JSON reader for the instance format: objects, arrays, strings
+// (escapes are skipped, not decoded), unsigned integers, and skipping of
+// any other value.
+class JsonReader
+{
+public:
+    explicit JsonReader(std::string_view text)
+        : text_(text)
+        , position_(text.data())
+        , end_(text.data() + text.size())
+    {}
+
+    // calls member(key) for each member, which has to consume the value
+    template<typename Member> void object(Member&& member)
+    {
+        expect('{');
+        if (peek() == '}') {
+            ++position_;
+            return;
+        }
+        do {
+            const std::string_view key = string();
+            expect(':');
+            member(key);
+        } while (accept(','));
+        expect('}');
+    }
+
+    // calls element() for each element, which has to consume it
+    template<typename Element> void array(Element&& element)
+    {
+        expect('[');
+        if (peek() == ']') {
+            ++position_;
+            return;
+        }
+        do {
+            element();
+        } while (accept(','));
+        expect(']');
+    }
+
+    std::string_view string()
+    {
+        expect('"');
+        const char* begin = position_;
+        while (position_ != end_ && *position_ != '"') {
+            position_ += *position_ == '\\' && position_ + 1 != end_ ? 2 : 1;
+        }
+        if (position_ == end_) {
+            fail(text_, begin, "unterminated string");
+        }
+        return {begin, static_cast<size_t>(position_++ - begin)};
+    }
+
+    unsigned int number()
+    {
+        peek();
+        unsigned int value  = 0;
+        auto [next, error] = std::from_chars(position_, end_, value);
+        if (error != std::errc{}) {
+            fail(text_, position_, "expected an unsigned integer");
+        }
+        position_ = next;
+        return value;
+    }
+
+    void skip()
+    {
+        switch (peek()) {
+        case '{': object([this](std::string_view) { skip(); }); break;
+        case '[': array([this]() { skip(); }); break;
+        case '"': string(); break;
+        default:
+            // number, true, false or null
+            while (position_ != end_ && !is_space(*position_) &&
+                   *position_ != ',' && *position_ != '}' &&
+                   *position_ != ']') {
+                ++position_;
+            }
+        }
+    }
+
+private:
+    char peek()
+    {
+        while (position_ != end_ && is_space(*position_)) {
+            ++position_;
+        }
+        if (position_ == end_) {
+            fail(text_, position_, "unexpected end of input");
+        }
+        return *position_;
+    }
+
+    bool accept(char c)
+    {
+        if (peek() == c) {
+            ++position_;
+            return true;
+        }
+        return false;
+    }
+
+    void expect(char c)
+    {
+        if (!accept(c)) {
+            fail(text_, position_, std::string("expected '") + c + "'");
+        }
+    }
+
+    std::string_view text_;
+    const char*      position_;
+    const char*      end_;
+};
+
+}   // namespace
+
+MappedFile::MappedFile(const std::string& path)
+{
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error(path + ": " + std::strerror(errno));
+    }
+    struct stat status
+    {};
+    if (::fstat(fd, &status) != 0) {
+        const int error = errno;
+        ::close(fd);
+        throw std::runtime_error(path + ": " + std::strerror(error));
+    }
+
+    size_ = static_cast<size_t>(status.st_size);
+    if (size_ > 0) {
+        data_ = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data_ == MAP_FAILED) {
+            const int error = errno;
+            data_           = nullptr;
+            ::close(fd);
+            throw std::runtime_error(path + ": " + std::strerror(error));
+        }
+        ::madvise(data_, size_, MADV_SEQUENTIAL);
+    }
+    ::close(fd);
+}
+
+MappedFile::~MappedFile()
+{
+    if (data_ != nullptr) {
+        ::munmap(data_, size_);
+    }
+}
+
+void load_instance(const std::string& path, JobShopInstance& instance,
+                   InstanceFormat format)
+{
+    const MappedFile       file(path);
+    const std::string_view text = file.view();
+
+    if (format == InstanceFormat::AUTO) {
+        const auto first = text.find_first_not_of(" \t\r\n");
+        if (path.ends_with(".json") ||
+            (first != std::string_view::npos && text[first] == '{')) {
+            format = InstanceFormat::JSON;
+        }
+        else if (text.find("Times") != std::string_view::npos) {
+            format = InstanceFormat::TAILLARD;
+        }
+        else {
+            format = InstanceFormat::ORLIB;
+        }
+    }
+
+    try {
+        switch (format) {
+        case InstanceFormat::ORLIB: parse_orlib(text, instance); break;
+        case InstanceFormat::TAILLARD: parse_taillard(text, instance); break;
+        case InstanceFormat::JSON: parse_json(text, instance); break;
+        case InstanceFormat::AUTO: break;
+        }
+    }
+    catch (const std::runtime_error& error) {
+        throw std::runtime_error(path + ": " + error.what());
+    }
+}
+
+void parse_orlib(std::string_view text, JobShopInstance& instance)
+{
+    // the header is the first line with exactly two integers, lines before
+    // it (instance names, comments) are skipped
+    unsigned int num_jobs     = 0;
+    unsigned int num_machines = 0;
+    const char*  position     = text.data();
+    const char*  end          = text.data() + text.size();
+    bool         found        = false;
+    while (!found && position != end) {
+        auto [line, next] = next_line(text, position);
+        found             = parse_pair(line, num_jobs, num_machines);
+        position          = next;
+    }
+    if (!found) {
+        fail(text, position, "missing \"jobs machines\" header");
+    }
+
+    const size_t num_ops = num_header_ops(
+        text.substr(position - text.data()), num_jobs, num_machines, 2);
+    std::vector<unsigned int> machines(num_ops);
+    std::vector<unsigned int> durations(num_ops);
+    NumberReader              reader(text, position);
+    for (size_t i = 0; i < machines.size(); ++i) {
+        machines[i]  = reader.next("a machine");
+        durations[i] = reader.next("a duration");
+        if (machines[i] >= num_machines) {
+            throw std::runtime_error("machine " + std::to_string(machines[i]) +
+                                     " out of range");
+        }
+    }
+    build_instance(num_jobs, num_machines, machines, durations, instance);
+}
+
+void parse_taillard(std::string_view text, JobShopInstance& instance)
+{
+    // "Nb of jobs, Nb of Machines, ..." then the values, the first two
+    // numbers of the file
+    const auto first_digit = text.find_first_of("0123456789");
+    if (first_digit == std::string_view::npos) {
+        throw std::runtime_error("missing \"jobs machines\" header");
+    }
+    NumberReader       header(text, text.data() + first_digit);
+    const unsigned int num_jobs     = header.next("the number of jobs");
+    const unsigned int num_machines = header.next("the number of machines");
+
+    // the sections follow each other, "Machines" is also in the header line
+    auto section = [&](std::string_view name, size_t from) {
+        const auto start = text.find(name, from);
+        if (start == std::string_view::npos) {
+            throw std::runtime_error("missing \"" + std::string(name) +
+                                     "\" section");
+        }
+        return NumberReader(text, text.data() + start + name.size());
+    };
+
+    const size_t num_ops = num_header_ops(
+        text.substr(header.offset()), num_jobs, num_machines, 2);
+    std::vector<unsigned int> durations(num_ops);
+    std::vector<unsigned int> machines(num_ops);
+    NumberReader              times = section("Times", header.offset());
+    for (auto& duration : durations) {
+        duration = times.next("a duration");
+    }
+    NumberReader machine_ids = section("Machines", times.offset());
+    for (auto& machine : machines) {
+        machine = machine_ids.next("a machine");
+        if (machine == 0 || machine > num_machines) {
+            throw std::runtime_error("machine " + std::to_string(machine) +
+                                     " out of range");
+        }
+        --machine;
+    }
+    build_instance(num_jobs, num_machines, machines, durations, instance);
+}
+
+void parse_json(std::string_view text, JobShopInstance& instance)
+{
+    struct JsonStep
+    {
+        MachineID  machine_id = 0;
+        TimePeriod duration   = 0;
+    };
+
+    instance.clear();
+    JsonReader            reader(text);
+    std::vector<JsonStep> steps;
+    JobID                 next_job = 0;
+
+    reader.object([&](std::string_view key) {
+        if (key != "jobs") {
+            reader.skip();
+            return;
+        }
+        reader.array([&]() {
+            JobID     job_id   = next_job++;
+            TimeStamp due_date = 0;
+            steps.clear();
+            reader.object([&](std::string_view job_key) {
+                if (job_key == "id") {
+                    job_id = reader.number();
+                }
+                else if (job_key == "due_date") {
+                    due_date = reader.number();
+                }
+                else if (job_key == "steps") {
+                    reader.array([&]() {
+                        JsonStep step;
+                        reader.object([&](std::string_view step_key) {
+                            if (step_key == "machine") {
+                                step.machine_id = reader.number();
+                            }
+                            else if (step_key == "duration") {
+                                step.duration = reader.number();
+                            }
+                            else {
+                                reader.skip();
+                            }
+                        });
+                        steps.push_back(step);
+                    });
+                }
+                else {
+                    reader.skip();
+                }
+            });
+
+            if (instance.jobs().contains(job_id)) {
+                throw std::runtime_error("duplicate job " +
+                                         std::to_string(job_id));
+            }
+            for (size_t i = 0; i < steps.size(); ++i) {
+                for (size_t j = 0; j < i; ++j) {
+                    if (steps[j].machine_id == steps[i].machine_id) {
+                        throw std::runtime_error(
+                            "job " + std::to_string(job_id) +
+                            " visits machine " +
+                            std::to_string(steps[i].machine_id) + " twice");
+                    }
+                }
+            }
+            instance.add_job(job_id, due_date);
+            for (StepID step_id = 0; step_id < steps.size(); ++step_id) {
+                instance.add_machine(steps[step_id].machine_id);
+                instance.add_step(job_id,
+                                  step_id,
+                                  steps[step_id].machine_id,
+                                  steps[step_id].duration);
+            }
+        });
+    });
+
+    // the ids index the jobs and machines of the compiled instance, they
+    // have to be dense from 0
+    if (!instance.jobs().empty() &&
+        instance.jobs().rbegin()->first >= instance.jobs().size()) {
+        throw std::runtime_error(
+            "job " + std::to_string(instance.jobs().rbegin()->first) +
+            " out of range");
+    }
+    if (!instance.machines().empty() &&
+        instance.machines().rbegin()->first >= instance.machines().size()) {
+        throw std::runtime_error(
+            "machine " + std::to_string(instance.machines().rbegin()->first) +
+            " out of range");
+    }
+}
+
+}   // namespace scheduling
@@ -5,13 +5,13 @@
 #include <vector>
 
 #include "jobShopInstance.hpp"
+#include "random.hpp"
 
 namespace scheduling {
 
 void JobShopInstance::generate_instance(int num_job, int num_machine)
 {
-    std::random_device rnd_dev;
-    std::mt19937       rnd_engine(rnd_dev());
+    auto& rnd_engine = thread_rng();
 
     // add machines
     for (int i = 0; i < num_machine; i++) {
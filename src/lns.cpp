@@ -0,0 +1,362 @@
+#include "lns.hpp"
+#include "compiledInstance.hpp"
+#include "cpSat.hpp"
+#include "disjunctiveGraph.hpp"
+#include "incumbent.hpp"
+#include "random.hpp"
+#include "solution.hpp"
+#include "telemetry.hpp"
+#include "types.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "ortools/sat/cp_model.h"
+#include "ortools/sat/cp_model.pb.h"
+#include "ortools/sat/cp_model_solver.h"
+#include "ortools/sat/model.h"
+#include "ortools/sat/sat_parameters.pb.h"
+#include "ortools/util/time_limit.h"
+
+
+namespace scheduling {
+
+namespace {
+
+constexpr double MIN_FRACTION = 0.02;
+constexpr double MAX_FRACTION = 0.5;
+
+// count random distinct indices in [0, size)
+std::vector<size_t> random_subset(size_t size, size_t count)
+{
+    std::vector<size_t> indices(size);
+    std::iota(indices.begin(), indices.end(), 0);
+    auto& rng = thread_rng();
+    for (size_t i = 0; i < count; ++i) {
+        std::swap(indices[i], indices[i + rng() % (size - i)]);
+    }
+    indices.resize(count);
+    return indices;
+}
+
+}   // namespace
+
+void LnsAlgorithm::solve(const CompiledInstance& instance,
+                         Incumbent&              incumbent)
+{
+    std::cout << "solve from lns algorithm solve func" << '\n';
+
+    // every worker of the pool solves its own subproblems, sharing the
+    // incumbent, until the time limit
+    run_workers(incumbent, [&](int worker, std::atomic<bool>& stop) {
+        search(instance, incumbent, stop, worker);
+    });
+}
+
+void LnsAlgorithm::relax(const DisjunctiveGraph& graph, Relaxation relaxation,
+                         double fraction, std::vector<char>& relaxed)
+{
+    const CompiledInstance& instance = graph.instance();
+    auto&                   rng      = thread_rng();
+    relaxed.assign(graph.num_ops(), 0);
+
+    switch (relaxation) {
+    case Relaxation::TIME_WINDOW: {
+        // the operations starting in [begin, begin + width)
+        const TimeStamp makespan = graph.makespan();
+        const TimeStamp width =
+            std::max<TimeStamp>(1, static_cast<TimeStamp>(fraction * makespan));
+        const TimeStamp begin =
+            makespan > width ? rng() % (makespan - width + 1) : 0;
+        for (OpID op = 0; op < graph.num_ops(); ++op) {
+            relaxed[op] =
+                graph.head(op) >= begin && graph.head(op) < begin + width;
+        }
+        break;
+    }
+    case Relaxation::MACHINES: {
+        const size_t count = std::clamp<size_t>(
+            fraction * instance.num_machines(), 1, instance.num_machines());
+        for (size_t machine : random_subset(instance.num_machines(), count)) {
+            for (OpID op : instance.machine_ops(machine)) {
+                relaxed[op] = 1;
+            }
+        }
+        break;
+    }
+    case Relaxation::JOBS: {
+        const size_t count = std::clamp<size_t>(
+            fraction * instance.num_jobs(), 1, instance.num_jobs());
+        for (size_t job : random_subset(instance.num_jobs(), count)) {
+            std::fill(relaxed.begin() + instance.job_begin(job),
+                      relaxed.begin() + instance.job_end(job), 1);
+        }
+        break;
+    }
+    }
+}
+
+DisjunctiveGraph LnsAlgorithm::repair_with_dispatching(
+    const DisjunctiveGraph& graph, const std::vector<char>& relaxed)
+{
+    const CompiledInstance& instance  = graph.instance();
+    const auto              durations = instance.op_durations();
+    const auto              machines  = instance.op_machines();
+    const auto              offsets   = instance.machine_offsets();
+    const size_t            num_jobs  = instance.num_jobs();
+
+    // the fixed operations of each machine, in their current order, and the
+    // new machine sequences, both laid out like the machine op lists
+    std::vector<OpID>   fixed(graph.num_ops());
+    std::vector<size_t> fixed_next(instance.num_machines());
+    std::vector<size_t> fixed_end(instance.num_machines());
+    std::vector<OpID>   sequence(graph.num_ops());
+    std::vector<size_t> sequence_end(offsets.begin(), offsets.end() - 1);
+    for (MachineID machine = 0; machine < instance.num_machines(); ++machine) {
+        fixed_next[machine] = fixed_end[machine] = offsets[machine];
+        for (OpID op : graph.machine_sequence(machine)) {
+            if (!relaxed[op]) {
+                fixed[fixed_end[machine]++] = op;
+            }
+        }
+    }
+
+    std::vector<OpID>       job_next(instance.job_offsets().begin(),
+                                     instance.job_offsets().end() - 1);
+    std::vector<TimeStamp>  job_ready(num_jobs, 0);
+    std::vector<TimePeriod> job_work(num_jobs, 0);
+    std::vector<TimeStamp>  machine_ready(instance.num_machines(), 0);
+    for (OpID op = 0; op < graph.num_ops(); ++op) {
+        job_work[instance.op_jobs()[op]] += durations[op];
+    }
+
+    // the next operation of a job can be scheduled when it is relaxed, or
+    // the next fixed operation of its machine
+    auto schedulable = [&](JobID job) {
+        if (job_next[job] == instance.job_end(job)) {
+            return false;
+        }
+        const OpID      op      = job_next[job];
+        const MachineID machine = machines[op];
+        return relaxed[op] != 0 || (fixed_next[machine] < fixed_end[machine] &&
+                                    fixed[fixed_next[machine]] == op);
+    };
+    auto start_time = [&](JobID job) {
+        return std::max(job_ready[job], machine_ready[machines[job_next[job]]]);
+    };
+
+    for (size_t scheduled = 0; scheduled < graph.num_ops(); ++scheduled) {
+        // the operation of the earliest completion
+        TimeStamp completion = std::numeric_limits<TimeStamp>::max();
+        JobID     chosen     = 0;
+        for (JobID job = 0; job < num_jobs; ++job) {
+            if (schedulable(job) &&
+                start_time(job) + durations[job_next[job]] < completion) {
+                completion = start_time(job) + durations[job_next[job]];
+                chosen     = job;
+            }
+        }
+
+        // of the operations that can start before it on its machine, the
+        // one with the most work remaining
+        const MachineID machine = machines[job_next[chosen]];
+        for (JobID job = 0; job < num_jobs; ++job) {
+            if (schedulable(job) && machines[job_next[job]] == machine &&
+                start_time(job) < completion &&
+                job_work[job] > job_work[chosen]) {
+                chosen = job;
+            }
+        }
+
+        const OpID      op  = job_next[chosen];
+        const TimeStamp end = start_time(chosen) + durations[op];
+        job_ready[chosen] = machine_ready[machine] = end;
+        job_work[chosen] -= durations[op];
+        ++job_next[chosen];
+        if (!relaxed[op]) {
+            ++fixed_next[machine];
+        }
+        sequence[sequence_end[machine]++] = op;
+    }
+
+    DisjunctiveGraph repaired(instance);
+    for (MachineID machine = 0; machine < instance.num_machines(); ++machine) {
+        const size_t size = offsets[machine + 1] - offsets[machine];
+        repaired.set_machine_sequence(
+            machine,
+            std::span<const OpID>(sequence).subspan(offsets[machine], size));
+    }
+    repaired.update();
+    return repaired;
+}
+
+bool LnsAlgorithm::repair_with_cp_sat(const DisjunctiveGraph&  graph,
+                                      const std::vector<char>& relaxed,
+                                      std::atomic<bool>&       stop,
+                                      DisjunctiveGraph&        repaired,
+                                      bool&                    optimal) const
+{
+    const CompiledInstance& instance  = graph.instance();
+    const auto              durations = instance.op_durations();
+    const auto              machines  = instance.op_machines();
+
+    // Only the relaxed operations are variables. The fixed ones keep their
+    // start times: they bound the relaxed steps of their jobs, and take
+    // fixed windows of the machines of the relaxed operations.
+    const int64_t       horizon = graph.makespan();
+    sat::CpModelBuilder builder;
+    std::vector<sat::IntVar> starts(graph.num_ops());
+    std::vector<sat::IntVar> relaxed_starts;
+    std::vector<std::vector<sat::IntervalVar>> machine_intervals(
+        instance.num_machines());
+    int64_t fixed_makespan = 0;
+    for (OpID op = 0; op < graph.num_ops(); ++op) {
+        if (relaxed[op]) {
+            starts[op] = builder.NewIntVar({0, horizon - durations[op]});
+            builder.AddHint(starts[op], graph.head(op));
+            relaxed_starts.push_back(starts[op]);
+            machine_intervals[machines[op]].push_back(
+                builder.NewFixedSizeIntervalVar(starts[op], durations[op]));
+        }
+        else {
+            fixed_makespan = std::max<int64_t>(
+                fixed_makespan, graph.head(op) + durations[op]);
+        }
+    }
+    if (relaxed_starts.empty()) {
+        return false;
+    }
+    for (OpID op = 0; op < graph.num_ops(); ++op) {
+        if (!relaxed[op] && !machine_intervals[machines[op]].empty()) {
+            machine_intervals[machines[op]].push_back(
+                builder.NewFixedSizeIntervalVar(
+                    sat::LinearExpr(graph.head(op)), durations[op]));
+        }
+    }
+    for (const auto& intervals : machine_intervals) {
+        if (!intervals.empty()) {
+            builder.AddNoOverlap(intervals);
+        }
+    }
+
+    // no worse than the current schedule, which is the hint
+    const sat::IntVar makespan = builder.NewIntVar({fixed_makespan, horizon});
+    builder.AddHint(makespan, horizon);
+    for (OpID op = 0; op < graph.num_ops(); ++op) {
+        if (!relaxed[op]) {
+            continue;
+        }
+        const OpID pred = graph.job_pred(op);
+        if (pred != DisjunctiveGraph::NONE) {
+            builder.AddLessOrEqual(
+                relaxed[pred] ? starts[pred] + durations[pred]
+                              : sat::LinearExpr(graph.head(pred) +
+                                                durations[pred]),
+                starts[op]);
+        }
+        const OpID succ = graph.job_succ(op);
+        if (succ == DisjunctiveGraph::NONE) {
+            builder.AddLessOrEqual(starts[op] + durations[op], makespan);
+        }
+        else if (!relaxed[succ]) {
+            builder.AddLessOrEqual(starts[op] + durations[op],
+                                   sat::LinearExpr(graph.head(succ)));
+        }
+    }
+
+    // the makespan first, then the relaxed operations as early as possible,
+    // which leaves room to the fixed ones once the schedule is left shifted
+    const int64_t weight =
+        static_cast<int64_t>(relaxed_starts.size()) * horizon + 1;
+    builder.Minimize(makespan * weight + sat::LinearExpr::Sum(relaxed_starts));
+
+    sat::SatParameters parameters;
+    parameters.set_num_workers(1);
+    parameters.set_max_time_in_seconds(subproblem_time_limit_);
+    parameters.set_random_seed(static_cast<int32_t>(thread_rng()() >> 33));
+
+    sat::Model sat_model;
+    sat_model.Add(sat::NewSatParameters(parameters));
+    sat_model.GetOrCreate<operations_research::TimeLimit>()
+        ->RegisterExternalBooleanAsLimit(&stop);
+
+    const sat::CpSolverResponse response =
+        sat::SolveCpModel(builder.Build(), &sat_model);
+    if (response.status() != sat::CpSolverStatus::OPTIMAL &&
+        response.status() != sat::CpSolverStatus::FEASIBLE) {
+        return false;
+    }
+    optimal = response.status() == sat::CpSolverStatus::OPTIMAL;
+
+    // the machine orders of the response, left shifted
+    thread_local std::vector<TimeStamp> start_times;
+    start_times.resize(graph.num_ops());
+    for (OpID op = 0; op < graph.num_ops(); ++op) {
+        start_times[op] =
+            relaxed[op] ? static_cast<TimeStamp>(
+                              sat::SolutionIntegerValue(response, starts[op]))
+                        : graph.head(op);
+    }
+    repaired = DisjunctiveGraph::from_start_times(start_times, instance);
+    return true;
+}
+
+void LnsAlgorithm::search(const CompiledInstance& instance,
+                          Incumbent& incumbent, std::atomic<bool>& stop,
+                          int worker) const
+{
+    auto& rng = thread_rng();
+
+    DisjunctiveGraph  current  = seed_graph(instance, incumbent, worker);
+    std::uint64_t     epoch    = incumbent.epoch();
+    double            fraction = 0.1;
+    std::vector<char> relaxed;
+
+    for (std::uint64_t iteration = 0; !stop.load(std::memory_order_relaxed);
+         ++iteration) {
+        // continue from the incumbent once someone else improved on it
+        if (incumbent.epoch() != epoch) {
+            epoch = incumbent.epoch();
+            if (incumbent.makespan() < current.makespan()) {
+                current = start_graph(instance, incumbent);
+            }
+        }
+
+        count(Counter::ITERATIONS);
+        relax(current, static_cast<Relaxation>(rng() % 3), fraction, relaxed);
+
+        // threads alternate between the two repairs, out of phase
+        DisjunctiveGraph candidate;
+        if ((iteration + worker) % 2 == 0) {
+            bool optimal = false;
+            if (!repair_with_cp_sat(
+                    current, relaxed, stop, candidate, optimal)) {
+                fraction = std::max(MIN_FRACTION, fraction * 0.9);
+                continue;
+            }
+            fraction = optimal ? std::min(MAX_FRACTION, fraction * 1.1)
+                               : std::max(MIN_FRACTION, fraction * 0.9);
+        }
+        else {
+            candidate = repair_with_dispatching(current, relaxed);
+        }
+
+        // sideways moves are accepted to keep the search moving
+        if (candidate.makespan() <= current.makespan()) {
+            current = std::move(candidate);
+            incumbent.try_publish(current.makespan(), [&current]() {
+                return current.to_solution();
+            });
+        }
+    }
+}
+
+}   // namespace scheduling
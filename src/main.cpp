@@ -1,17 +1,51 @@
+#include <chrono>
+#include <cstdint>
+#include <fstream>
 #include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
 
 #include "absl/flags/flag.h"
 #include "absl/flags/parse.h"
 #include "absl/flags/usage.h"
 
 #include "algorithm.hpp"
+#include "decoder.hpp"
+#include "instanceLoader.hpp"
 #include "jobShopInstance.hpp"
+#include "random.hpp"
 #include "run.hpp"
+#include "snapshot.hpp"
 
 ABSL_FLAG(int, num_jobs, 10, "Number of jobs for the test instance");
 ABSL_FLAG(int, num_machines, 10, "Number of machines for the test instance");
 ABSL_FLAG(int, num_threads, 4, "Number of threads for solving process");
 ABSL_FLAG(int, time_limit, 10, "Time limit of solving process");
+ABSL_FLAG(bool, cpu_affinity, false,
+          "Pin the threads of each algorithm to their own cpus");
+ABSL_FLAG(int, grasp_starts, 100,
+          "Number of GRASP starts that seed the incumbent and the algorithms");
+ABSL_FLAG(std::string, instance, "",
+          "Instance file to solve instead of a generated instance");
+ABSL_FLAG(std::string, format, "auto",
+          "Format of the instance file: auto, orlib, taillard or json");
+ABSL_FLAG(std::string, snapshot, "",
+          "Snapshot to resume from: its instance, warm started from its "
+          "schedule");
+ABSL_FLAG(std::string, save_snapshot, "",
+          "Save the instance and the best schedule to this snapshot file");
+ABSL_FLAG(std::string, telemetry, "",
+          "Write JSON lines of solver telemetry to this file, - for stderr");
+ABSL_FLAG(int, telemetry_interval_ms, 1000,
+          "Interval between two telemetry lines, in milliseconds");
+ABSL_FLAG(std::string, decode_mode, "semi_active",
+          "Decoder of the GA chromosomes: semi_active, active or "
+          "giffler_thompson");
+ABSL_FLAG(double, decode_delay, 1.0,
+          "Giffler-Thompson delay in [0, 1]: 0 non-delay, 1 active schedules");
+ABSL_FLAG(uint64_t, seed, 0,
+          "Master random seed for reproducible runs, 0 for a random seed");
 
 
 int main(int argc, char** argv)
@@ -26,21 +60,75 @@ int main(int argc, char** argv)
         "    ./job_shop_scheduling --num_jobs=<int> --num_machines=<int> \n "
         "Options:\n"
         "    -num_jobs   The number of jobs for the test instance. \n"
-        "    -num_machines   The number of machines for the test instance. ");
+        "    -num_machines   The number of machines for the test instance. \n"
+        "    -instance   An OR-Library, Taillard or JSON instance file. \n"
+        "    -format   The instance file format, auto by default. \n"
+        "    -snapshot   Resume from a snapshot file. \n"
+        "    -save_snapshot   Save the final state to a snapshot file. \n"
+        "    -telemetry   Write progress as JSON lines to a file. \n"
+        "    -decode_mode   The GA decoder, semi_active by default. \n"
+        "    -seed   The master random seed, to reproduce a run. ");
     absl::ParseCommandLine(argc, argv);
 
     int num_jobs     = absl::GetFlag(FLAGS_num_jobs);   // Fixed flag name
     int num_machines = absl::GetFlag(FLAGS_num_machines);
     int num_threads  = absl::GetFlag(FLAGS_num_threads);
     int time_limit   = absl::GetFlag(FLAGS_time_limit);
+    if (uint64_t seed = absl::GetFlag(FLAGS_seed); seed != 0) {
+        scheduling::set_master_seed(seed);
+    }
 
     std::cout << "num of jobs: " << num_jobs
               << ", num of machines: " << num_machines
               << ", num of threads: " << num_threads
-              << ", time limit: " << time_limit << "\n";
+              << ", time limit: " << time_limit
+              << ", seed: " << scheduling::master_seed() << "\n";
 
     scheduling::JobShopInstance instance;
-    instance.generate_instance(num_jobs, num_machines);
+    std::unique_ptr<scheduling::SnapshotFile> snapshot;
+    if (const std::string path = absl::GetFlag(FLAGS_snapshot); !path.empty()) {
+        try {
+            snapshot = std::make_unique<scheduling::SnapshotFile>(path);
+        }
+        catch (const std::runtime_error& error) {
+            std::cerr << error.what() << '\n';
+            return 1;
+        }
+        snapshot->to_instance(instance);
+        std::cout << "snapshot " << path << ": " << snapshot->num_jobs()
+                  << " jobs, " << snapshot->num_machines() << " machines"
+                  << ", makespan " << snapshot->makespan() << "\n";
+    }
+    else if (const std::string path = absl::GetFlag(FLAGS_instance);
+             path.empty()) {
+        instance.generate_instance(num_jobs, num_machines);
+    }
+    else {
+        const std::string format = absl::GetFlag(FLAGS_format);
+        auto              instance_format = scheduling::InstanceFormat::AUTO;
+        if (format == "orlib") {
+            instance_format = scheduling::InstanceFormat::ORLIB;
+        }
+        else if (format == "taillard") {
+            instance_format = scheduling::InstanceFormat::TAILLARD;
+        }
+        else if (format == "json") {
+            instance_format = scheduling::InstanceFormat::JSON;
+        }
+        else if (format != "auto") {
+            std::cerr << "unknown instance format: " << format << '\n';
+            return 1;
+        }
+        try {
+            scheduling::load_instance(path, instance, instance_format);
+        }
+        catch (const std::runtime_error& error) {
+            std::cerr << error.what() << '\n';
+            return 1;
+        }
+        std::cout << "instance " << path << ": " << instance.jobs().size()
+                  << " jobs, " << instance.machines().size() << " machines\n";
+    }
     // instance.print();
 
     // test for solution constructor
@@ -63,8 +151,42 @@ int main(int argc, char** argv)
 
     // test for scheduling Run
     scheduling::Run run{instance, num_threads, time_limit};
+    run.set_cpu_affinity(absl::GetFlag(FLAGS_cpu_affinity));
+    run.set_grasp_starts(absl::GetFlag(FLAGS_grasp_starts));
+    try {
+        run.set_decode_mode(
+            scheduling::parse_decode_mode(absl::GetFlag(FLAGS_decode_mode)),
+            absl::GetFlag(FLAGS_decode_delay));
+    }
+    catch (const std::invalid_argument& error) {
+        std::cerr << error.what() << '\n';
+        return 1;
+    }
+    std::ofstream telemetry_file;
+    if (const std::string path = absl::GetFlag(FLAGS_telemetry);
+        !path.empty()) {
+        std::ostream* out = &std::cerr;
+        if (path != "-") {
+            telemetry_file.open(path);
+            out = &telemetry_file;
+        }
+        run.set_telemetry(
+            out,
+            std::chrono::milliseconds(
+                absl::GetFlag(FLAGS_telemetry_interval_ms)));
+    }
+    if (snapshot != nullptr && snapshot->has_solution()) {
+        const scheduling::CompiledInstance compiled(instance);
+        run.warm_start(snapshot->to_solution(compiled));
+    }
     run();
 
+    if (const std::string path = absl::GetFlag(FLAGS_save_snapshot);
+        !path.empty()) {
+        scheduling::save_snapshot(path, instance, run.best().get());
+        std::cout << "saved snapshot " << path << "\n";
+    }
+
 
     return 0;
 }
@@ -0,0 +1,98 @@
+#include "qualityTrace.hpp"
+#include "types.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <vector>
+
+
+namespace scheduling {
+
+namespace {
+
+double primal_gap(Fitness makespan, Fitness reference)
+{
+    const Fitness larger = std::max(makespan, reference);
+    if (larger == 0) {
+        return 0.0;
+    }
+    const Fitness difference =
+        makespan > reference ? makespan - reference : reference - makespan;
+    return static_cast<double>(difference) / larger;
+}
+
+}   // namespace
+
+void QualityTrace::start()
+{
+    const std::lock_guard lock(mutex_);
+    start_ = Clock::now();
+    points_.clear();
+}
+
+void QualityTrace::record(Fitness makespan)
+{
+    const std::lock_guard lock(mutex_);
+    // improvements claimed on several threads may be recorded out of order
+    if (points_.empty() || makespan < points_.back().makespan) {
+        points_.push_back({elapsed(), makespan});
+    }
+}
+
+double QualityTrace::elapsed() const
+{
+    return std::chrono::duration<double>(Clock::now() - start_).count();
+}
+
+std::vector<QualityTrace::Point> QualityTrace::points() const
+{
+    const std::lock_guard lock(mutex_);
+    return points_;
+}
+
+double QualityTrace::primal_integral(std::span<const Point> points,
+                                     Fitness reference, double horizon)
+{
+    double integral = 0.0;
+    double time     = 0.0;
+    double gap      = 1.0;   // no solution yet
+    for (const Point& point : points) {
+        const double until = std::min(point.seconds, horizon);
+        if (until > time) {
+            integral += gap * (until - time);
+            time = until;
+        }
+        gap = primal_gap(point.makespan, reference);
+    }
+    if (horizon > time) {
+        integral += gap * (horizon - time);
+    }
+    return integral;
+}
+
+std::optional<double> QualityTrace::time_to_target(
+    std::span<const Point> points, Fitness target)
+{
+    const auto reached =
+        std::ranges::find_if(points, [target](const Point& point) {
+            return point.makespan <= target;
+        });
+    if (reached == points.end()) {
+        return std::nullopt;
+    }
+    return reached->seconds;
+}
+
+std::optional<Fitness> QualityTrace::final_makespan(
+    std::span<const Point> points)
+{
+    if (points.empty()) {
+        return std::nullopt;
+    }
+    return std::ranges::min(points, {}, &Point::makespan).makespan;
+}
+
+}   // namespace scheduling
@@ -0,0 +1,95 @@
+#include "random.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <random>
+
+
+namespace scheduling {
+
+namespace {
+
+std::uint64_t initial_seed()
+{
+    std::random_device rnd_dev;
+    return (static_cast<std::uint64_t>(rnd_dev()) << 32) | rnd_dev();
+}
+
+std::atomic<std::uint64_t> g_master_seed{initial_seed()};
+std::atomic<std::uint64_t> g_seed_epoch{1};
+std::atomic<std::uint64_t> g_next_stream{0};
+
+struct ThreadRandom
+{
+    RandomEngine  engine;
+    std::uint64_t stream = 0;
+    std::uint64_t epoch  = 0;   // 0: stream not assigned yet
+};
+
+thread_local ThreadRandom t_random;
+
+std::uint64_t stream_seed(std::uint64_t stream)
+{
+    return RandomEngine::splitmix64(
+        g_master_seed.load(std::memory_order_relaxed) ^
+        RandomEngine::splitmix64(stream + 0x9E3779B97F4A7C15ULL));
+}
+
+}   // namespace
+
+
+void set_master_seed(std::uint64_t seed)
+{
+    g_master_seed.store(seed, std::memory_order_relaxed);
+    g_seed_epoch.fetch_add(1, std::memory_order_release);
+}
+
+std::uint64_t master_seed()
+{
+    return g_master_seed.load(std::memory_order_relaxed);
+}
+
+void set_thread_stream(std::uint64_t stream)
+{
+    t_random.stream = stream;
+    t_random.epoch  = g_seed_epoch.load(std::memory_order_acquire);
+    t_random.engine.seed(stream_seed(stream));
+}
+
+RandomEngine& thread_rng()
+{
+    const auto epoch = g_seed_epoch.load(std::memory_order_acquire);
+    if (t_random.epoch != epoch) {
+        if (t_random.epoch == 0) {
+            t_random.stream =
+                g_next_stream.fetch_add(1, std::memory_order_relaxed);
+        }
+        t_random.epoch = epoch;
+        t_random.engine.seed(stream_seed(t_random.stream));
+    }
+    return t_random.engine;
+}
+
+std::uint64_t task_stream(std::uint64_t stream, std::uint64_t index)
+{
+    return RandomEngine::splitmix64(
+        stream ^ RandomEngine::splitmix64(index + 0x9E3779B97F4A7C15ULL));
+}
+
+ScopedThreadStream::ScopedThreadStream(std::uint64_t stream)
+    : engine_(t_random.engine)
+    , stream_(t_random.stream)
+    , epoch_(t_random.epoch)
+{
+    set_thread_stream(stream);
+}
+
+ScopedThreadStream::~ScopedThreadStream()
+{
+    // in place: references from thread_rng() stay valid
+    t_random.engine = engine_;
+    t_random.stream = stream_;
+    t_random.epoch  = epoch_;
+}
+
+}   // namespace scheduling
@@ -0,0 +1,292 @@
+#include "snapshot.hpp"
+#include "compiledInstance.hpp"
+#include "disjunctiveGraph.hpp"
+#include "instanceLoader.hpp"
+#include "jobShopInstance.hpp"
+#include "solution.hpp"
+#include "types.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace scheduling {
+
+static_assert(sizeof(unsigned int) == sizeof(std::uint32_t),
+              "snapshot arrays are used in place as unsigned int");
+
+namespace {
+
+// header fields, byte offsets
+constexpr size_t VERSION_AT         = 8;
+constexpr size_t HEADER_SIZE_AT     = 12;
+constexpr size_t NUM_JOBS_AT        = 16;
+constexpr size_t NUM_MACHINES_AT    = 20;
+constexpr size_t NUM_OPS_AT         = 24;
+constexpr size_t FLAGS_AT           = 28;
+constexpr size_t MAKESPAN_AT        = 32;
+constexpr size_t CHROMOSOME_SIZE_AT = 36;
+constexpr size_t FILE_SIZE_AT       = 40;
+
+constexpr std::uint32_t HAS_SCHEDULE   = 1;
+constexpr std::uint32_t HAS_CHROMOSOME = 2;
+
+// bytes of an array of count u32, padded to 8
+size_t array_size(size_t count)
+{
+    return (count * sizeof(std::uint32_t) + 7) & ~size_t{7};
+}
+
+// little-endian stores, whatever the host
+void store_u32(char* out, std::uint32_t value)
+{
+    for (int i = 0; i < 4; ++i) {
+        out[i] = static_cast<char>(value >> (8 * i));
+    }
+}
+
+void store_u64(char* out, std::uint64_t value)
+{
+    for (int i = 0; i < 8; ++i) {
+        out[i] = static_cast<char>(value >> (8 * i));
+    }
+}
+
+// appends the values as one array
+class SnapshotWriter
+{
+public:
+    explicit SnapshotWriter(std::string& buffer)
+        : buffer_(buffer)
+    {}
+
+    template<typename Values> void array(const Values& values)
+    {
+        const size_t offset = buffer_.size();
+        buffer_.resize(offset + array_size(std::size(values)), '\0');
+        char* out = buffer_.data() + offset;
+        for (const auto value : values) {
+            store_u32(out, static_cast<std::uint32_t>(value));
+            out += sizeof(std::uint32_t);
+        }
+    }
+
+private:
+    std::string& buffer_;
+};
+
+// hands out the arrays of a mapped snapshot in order
+class SnapshotReader
+{
+public:
+    SnapshotReader(std::string_view data, size_t offset)
+        : data_(data)
+        , offset_(offset)
+    {}
+
+    template<typename T> std::span<const T> array(size_t count)
+    {
+        if (offset_ + array_size(count) > data_.size()) {
+            throw std::runtime_error("snapshot truncated");
+        }
+        const auto* values =
+            reinterpret_cast<const T*>(data_.data() + offset_);
+        offset_ += array_size(count);
+        return {values, count};
+    }
+
+private:
+    std::string_view data_;
+    size_t           offset_;
+};
+
+std::uint32_t load_u32(std::string_view data, size_t at)
+{
+    std::uint32_t value = 0;
+    std::memcpy(&value, data.data() + at, sizeof(value));
+    return value;
+}
+
+std::uint64_t load_u64(std::string_view data, size_t at)
+{
+    std::uint64_t value = 0;
+    std::memcpy(&value, data.data() + at, sizeof(value));
+    return value;
+}
+
+}   // namespace
+
+SnapshotFile::SnapshotFile(const std::string& path)
+    : file_(path)
+{
+    if constexpr (std::endian::native != std::endian::little) {
+        throw std::runtime_error(path +
+                                 ": snapshots need a little-endian host");
+    }
+
+    const std::string_view data = file_.view();
+    auto                   fail = [&path](const std::string& what) {
+        throw std::runtime_error(path + ": " + what);
+    };
+    if (data.size() < HEADER_SIZE ||
+        std::memcmp(data.data(), MAGIC, sizeof(MAGIC)) != 0) {
+        fail("not a snapshot");
+    }
+    if (load_u32(data, VERSION_AT) != VERSION) {
+        fail("unsupported snapshot version " +
+             std::to_string(load_u32(data, VERSION_AT)));
+    }
+    if (load_u32(data, HEADER_SIZE_AT) != HEADER_SIZE ||
+        load_u64(data, FILE_SIZE_AT) != data.size()) {
+        fail("snapshot truncated");
+    }
+
+    num_jobs_                   = load_u32(data, NUM_JOBS_AT);
+    num_machines_               = load_u32(data, NUM_MACHINES_AT);
+    num_ops_                    = load_u32(data, NUM_OPS_AT);
+    makespan_                   = load_u32(data, MAKESPAN_AT);
+    const std::uint32_t flags   = load_u32(data, FLAGS_AT);
+    const size_t chromosome_size = load_u32(data, CHROMOSOME_SIZE_AT);
+
+    try {
+        SnapshotReader reader(data, HEADER_SIZE);
+        job_ids_      = reader.array<JobID>(num_jobs_);
+        due_dates_    = reader.array<TimeStamp>(num_jobs_);
+        job_offsets_  = reader.array<OpID>(num_jobs_ + 1);
+        machine_ids_  = reader.array<MachineID>(num_machines_);
+        op_machines_  = reader.array<MachineID>(num_ops_);
+        op_durations_ = reader.array<TimePeriod>(num_ops_);
+        op_steps_     = reader.array<StepID>(num_ops_);
+        if ((flags & HAS_SCHEDULE) != 0) {
+            start_times_ = reader.array<TimeStamp>(num_ops_);
+        }
+        if ((flags & HAS_CHROMOSOME) != 0) {
+            chromosome_ = reader.array<unsigned int>(chromosome_size);
+        }
+    }
+    catch (const std::runtime_error& error) {
+        fail(error.what());
+    }
+
+    // the arrays are used as indices, check them once here
+    if (job_offsets_.front() != 0 || job_offsets_.back() != num_ops_ ||
+        !std::ranges::is_sorted(job_offsets_)) {
+        fail("invalid job offsets");
+    }
+    if (std::ranges::any_of(op_machines_, [this](MachineID machine) {
+            return machine >= num_machines_;
+        })) {
+        fail("machine index out of range");
+    }
+}
+
+void SnapshotFile::to_instance(JobShopInstance& instance) const
+{
+    instance.clear();
+    for (MachineID machine_id : machine_ids_) {
+        instance.add_machine(machine_id);
+    }
+    for (JobID job = 0; job < num_jobs_; ++job) {
+        instance.add_job(job_ids_[job], due_dates_[job]);
+        for (OpID op = job_offsets_[job]; op < job_offsets_[job + 1]; ++op) {
+            instance.add_step(job_ids_[job],
+                              op_steps_[op],
+                              machine_ids_[op_machines_[op]],
+                              op_durations_[op]);
+        }
+    }
+}
+
+Solution SnapshotFile::to_solution(const CompiledInstance& instance) const
+{
+    if (!has_solution()) {
+        throw std::runtime_error("snapshot without a schedule");
+    }
+    if (instance.num_ops() != num_ops_) {
+        throw std::runtime_error("snapshot of another instance");
+    }
+    Solution solution =
+        DisjunctiveGraph::from_start_times(start_times_, instance)
+            .to_solution();
+    if (!chromosome_.empty()) {
+        solution.chromo.assign(chromosome_.begin(), chromosome_.end());
+    }
+    return solution;
+}
+
+void save_snapshot(const std::string& path, const JobShopInstance& instance,
+                   const Solution* solution)
+{
+    const CompiledInstance compiled(instance);
+
+    std::vector<TimeStamp> due_dates;
+    due_dates.reserve(compiled.num_jobs());
+    for (const auto& [job_id, job] : instance.jobs()) {
+        due_dates.push_back(job.due_date);
+    }
+
+    std::vector<TimeStamp> start_times;
+    Chromosome             chromosome;
+    if (solution != nullptr) {
+        if (solution->num_ops() != compiled.num_ops()) {
+            throw std::runtime_error(path + ": schedule of another instance");
+        }
+        start_times = solution->start_times;
+        chromosome = !solution->chromo.empty()
+                         ? solution->chromo
+                         : DisjunctiveGraph::from_start_times(start_times,
+                                                              compiled)
+                               .to_chromosome();
+    }
+
+    std::string buffer(SnapshotFile::HEADER_SIZE, '\0');
+    std::memcpy(
+        buffer.data(), SnapshotFile::MAGIC, sizeof(SnapshotFile::MAGIC));
+    SnapshotWriter writer(buffer);
+    writer.array(compiled.job_ids());
+    writer.array(due_dates);
+    writer.array(compiled.job_offsets());
+    writer.array(compiled.machine_ids());
+    writer.array(compiled.op_machines());
+    writer.array(compiled.op_durations());
+    writer.array(compiled.op_steps());
+    if (solution != nullptr) {
+        writer.array(start_times);
+        writer.array(chromosome);
+    }
+
+    char* header = buffer.data();
+    store_u32(header + VERSION_AT, SnapshotFile::VERSION);
+    store_u32(header + HEADER_SIZE_AT, SnapshotFile::HEADER_SIZE);
+    store_u32(header + NUM_JOBS_AT, compiled.num_jobs());
+    store_u32(header + NUM_MACHINES_AT, compiled.num_machines());
+    store_u32(header + NUM_OPS_AT, compiled.num_ops());
+    store_u32(header + FLAGS_AT,
+              solution != nullptr ? HAS_SCHEDULE | HAS_CHROMOSOME : 0);
+    store_u32(header + MAKESPAN_AT,
+              solution != nullptr ? solution->makespan : 0);
+    store_u32(header + CHROMOSOME_SIZE_AT, chromosome.size());
+    store_u64(header + FILE_SIZE_AT, buffer.size());
+
+    const std::string temporary = path + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        if (!out) {
+            throw std::runtime_error(temporary + ": write failed");
+        }
+    }
+    std::filesystem::rename(temporary, path);
+}
+
+}   // namespace scheduling
@@ -0,0 +1,300 @@
+#include "tabuSearch.hpp"
+#include "algorithm.hpp"
+#include "compiledInstance.hpp"
+#include "disjunctiveGraph.hpp"
+#include "incumbent.hpp"
+#include "random.hpp"
+#include "solution.hpp"
+#include "telemetry.hpp"
+#include "types.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+
+namespace scheduling {
+
+void TabuSearchAlgorithm::solve(const CompiledInstance& instance,
+                                Incumbent&              incumbent)
+{
+    std::cout << "solve from tabu search algorithm solve func" << '\n';
+
+    // independent searches, one per worker of the pool, sharing the
+    // incumbent until the time limit
+    run_workers(incumbent, [&](int worker, std::atomic<bool>& stop) {
+        search(instance, incumbent, stop, worker);
+    });
+}
+
+void TabuSearchAlgorithm::generate_moves(const DisjunctiveGraph& graph,
+                                         Neighborhood            neighborhood,
+                                         std::vector<Move>&      moves)
+{
+    moves.clear();
+    const auto blocks = graph.critical_blocks();
+
+    auto add_move = [&](MachineID machine, size_t from, size_t to) {
+        const auto sequence = graph.machine_sequence(machine);
+        const OpID moved    = sequence[from];
+        const OpID pivot    = sequence[to];
+
+        // skip insertions that may close a cycle (Balas & Vazacopoulos):
+        // moving u right after v is safe when the tail of v is at least the
+        // one of the job successor of u, and symmetrically for heads
+        if (from < to) {
+            const OpID succ = graph.job_succ(moved);
+            if (succ != DisjunctiveGraph::NONE &&
+                graph.duration(pivot) + graph.tail(pivot) <
+                    graph.duration(succ) + graph.tail(succ)) {
+                return;
+            }
+        }
+        else {
+            const OpID pred = graph.job_pred(moved);
+            if (pred != DisjunctiveGraph::NONE &&
+                graph.head(pivot) + graph.duration(pivot) <
+                    graph.head(pred) + graph.duration(pred)) {
+                return;
+            }
+        }
+        moves.push_back({machine, from, to, moved, pivot,
+                         estimate_move(graph, machine, from, to)});
+    };
+
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        const auto [machine, begin, end] = blocks[i];
+        const size_t size                = end - begin;
+        if (size < 2) {
+            continue;
+        }
+
+        // N5: swapping the first two operations of the first block or the
+        // last two of the last block can't shorten the path
+        const bool first = i == 0;
+        const bool last  = i + 1 == blocks.size();
+        if (!first) {
+            add_move(machine, begin, begin + 1);
+        }
+        if (!last && (size > 2 || first)) {
+            add_move(machine, end - 2, end - 1);
+        }
+
+        if (neighborhood != Neighborhood::N7 || size < 3) {
+            continue;
+        }
+
+        // N7: inner operations to the front or back of the block, the first
+        // and last operation into (or across) the block
+        for (size_t pos = begin + 1; pos + 1 < end; ++pos) {
+            add_move(machine, pos, begin);
+            add_move(machine, pos, end - 1);
+            add_move(machine, begin, pos);
+            add_move(machine, end - 1, pos);
+        }
+        add_move(machine, begin, end - 1);
+        add_move(machine, end - 1, begin);
+    }
+}
+
+TimeStamp TabuSearchAlgorithm::estimate_move(const DisjunctiveGraph& graph,
+                                             MachineID machine, size_t from,
+                                             size_t to)
+{
+    const auto   sequence = graph.machine_sequence(machine);
+    const size_t low      = std::min(from, to);
+    const size_t high     = std::max(from, to);
+
+    // the machine order of positions [low, high] after the move
+    thread_local std::vector<OpID>      ops;
+    thread_local std::vector<TimeStamp> heads;
+    ops.assign(sequence.begin() + low, sequence.begin() + high + 1);
+    if (from < to) {
+        std::rotate(ops.begin(), ops.begin() + 1, ops.end());
+    }
+    else {
+        std::rotate(ops.begin(), ops.end() - 1, ops.end());
+    }
+
+    // heads forward from the machine predecessor of the segment, tails
+    // backward from its machine successor, job neighbors keep their values
+    heads.resize(ops.size());
+    TimeStamp machine_ready = 0;
+    if (low > 0) {
+        machine_ready =
+            graph.head(sequence[low - 1]) + graph.duration(sequence[low - 1]);
+    }
+    for (size_t i = 0; i < ops.size(); ++i) {
+        const OpID op   = ops[i];
+        TimeStamp  head = machine_ready;
+        if (OpID pred = graph.job_pred(op); pred != DisjunctiveGraph::NONE) {
+            head = std::max(head, graph.head(pred) + graph.duration(pred));
+        }
+        heads[i]      = head;
+        machine_ready = head + graph.duration(op);
+    }
+
+    TimeStamp machine_tail = 0;
+    if (high + 1 < sequence.size()) {
+        const OpID next = sequence[high + 1];
+        machine_tail    = graph.duration(next) + graph.tail(next);
+    }
+    TimeStamp estimate = 0;
+    for (size_t i = ops.size(); i-- > 0;) {
+        const OpID op   = ops[i];
+        TimeStamp  tail = machine_tail;
+        if (OpID succ = graph.job_succ(op); succ != DisjunctiveGraph::NONE) {
+            tail = std::max(tail, graph.duration(succ) + graph.tail(succ));
+        }
+        estimate     = std::max(estimate, heads[i] + graph.duration(op) + tail);
+        machine_tail = graph.duration(op) + tail;
+    }
+    return estimate;
+}
+
+void TabuSearchAlgorithm::search(const CompiledInstance& instance,
+                                 Incumbent&              incumbent,
+                                 std::atomic<bool>&      stop,
+                                 int                     worker) const
+{
+    auto& rng = thread_rng();
+
+    // workers without a seed of their own start from the incumbent, and
+    // all but the first one perturb it
+    DisjunctiveGraph graph = seed_graph(instance, incumbent, worker);
+    if (worker > 0 && static_cast<size_t>(worker) >= seeds_.size()) {
+        perturb(graph, worker);
+    }
+    DisjunctiveGraph best = graph;
+
+    // random tenure in [min_tenure, 3/2 min_tenure]
+    const int min_tenure =
+        10 + static_cast<int>(instance.num_jobs() /
+                              std::max<size_t>(1, instance.num_machines()));
+    std::uniform_int_distribution<int> tenure(min_tenure,
+                                              min_tenure + min_tenure / 2);
+
+    std::vector<Move>    moves;
+    std::vector<TabuArc> tabu_list;
+    std::uint64_t        iteration  = 0;
+    int                  no_improve = 0;
+
+    while (!stop.load(std::memory_order_relaxed)) {
+        ++iteration;
+        count(Counter::ITERATIONS);
+
+        // best admissible move, tabu moves only when they beat the best
+        // makespan of this search (aspiration), ties broken at random
+        generate_moves(graph, neighborhood_, moves);
+        const Move* chosen = nullptr;
+        size_t      ties   = 0;
+        for (const Move& move : moves) {
+            if (move.estimate >= best.makespan() &&
+                is_tabu(tabu_list, move, iteration)) {
+                continue;
+            }
+            if (chosen == nullptr || move.estimate < chosen->estimate) {
+                chosen = &move;
+                ties   = 1;
+            }
+            else if (move.estimate == chosen->estimate &&
+                     rng() % ++ties == 0) {
+                chosen = &move;
+            }
+        }
+        if (chosen == nullptr) {
+            perturb(graph, 2);
+            tabu_list.clear();
+            continue;
+        }
+
+        const Move move = *chosen;
+        graph.move_on_machine(move.machine, move.from, move.to);
+        if (!graph.update()) {
+            // the estimate filter is not exact, undo and forbid the move
+            graph.move_on_machine(move.machine, move.to, move.from);
+            graph.update();
+            if (move.from < move.to) {
+                tabu_list.push_back(
+                    {move.pivot, move.moved, iteration + tenure(rng)});
+            }
+            else {
+                tabu_list.push_back(
+                    {move.moved, move.pivot, iteration + tenure(rng)});
+            }
+            continue;
+        }
+
+        // forbid restoring the old order of the moved pair
+        const std::uint64_t expires = iteration + tenure(rng);
+        if (move.from < move.to) {
+            tabu_list.push_back({move.moved, move.pivot, expires});
+        }
+        else {
+            tabu_list.push_back({move.pivot, move.moved, expires});
+        }
+        std::erase_if(tabu_list, [iteration](const TabuArc& arc) {
+            return arc.expires <= iteration;
+        });
+
+        if (graph.makespan() < best.makespan()) {
+            best       = graph;
+            no_improve = 0;
+            incumbent.try_publish(best.makespan(),
+                                  [&best]() { return best.to_solution(); });
+        }
+        else if (++no_improve >= max_no_improve_) {
+            // restart from the better of this search's best and the
+            // incumbent, slightly perturbed
+            graph = incumbent.makespan() < best.makespan()
+                        ? start_graph(instance, incumbent)
+                        : best;
+            perturb(graph, 2 + static_cast<int>(rng() % 4));
+            tabu_list.clear();
+            no_improve = 0;
+        }
+    }
+}
+
+void TabuSearchAlgorithm::perturb(DisjunctiveGraph& graph, int num_moves)
+{
+    auto&           rng      = thread_rng();
+    const MachineID machines = graph.instance().num_machines();
+    if (machines == 0) {
+        return;
+    }
+
+    // random adjacent swaps, undone when they make the graph cyclic
+    for (int i = 0; i < num_moves; ++i) {
+        const MachineID machine = rng() % machines;
+        const size_t    size    = graph.machine_sequence(machine).size();
+        if (size < 2) {
+            continue;
+        }
+        const size_t position = rng() % (size - 1);
+        graph.move_on_machine(machine, position, position + 1);
+        if (!graph.update()) {
+            graph.move_on_machine(machine, position + 1, position);
+            graph.update();
+        }
+    }
+}
+
+bool TabuSearchAlgorithm::is_tabu(const std::vector<TabuArc>& tabu_list,
+                                  const Move& move, std::uint64_t iteration)
+{
+    // the arc the move creates between the moved operation and the pivot
+    const OpID before = move.from < move.to ? move.pivot : move.moved;
+    const OpID after  = move.from < move.to ? move.moved : move.pivot;
+    return std::ranges::any_of(tabu_list, [&](const TabuArc& arc) {
+        return arc.before == before && arc.after == after &&
+               arc.expires > iteration;
+    });
+}
+
+}   // namespace scheduling
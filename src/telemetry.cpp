@@ -0,0 +1,150 @@
+#include "telemetry.hpp"
+#include "incumbent.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+
+namespace scheduling {
+
+namespace {
+
+// the live slots, and the totals of the threads that exited
+struct Registry
+{
+    std::mutex                   mutex;
+    std::vector<ThreadCounters*> live;
+    CounterValues                retired{};
+};
+
+Registry& registry()
+{
+    static Registry registry;
+    return registry;
+}
+
+// registers its counters for the lifetime of the thread
+struct ThreadSlot
+{
+    ThreadCounters counters;
+
+    ThreadSlot()
+    {
+        const std::lock_guard lock(registry().mutex);
+        registry().live.push_back(&counters);
+    }
+
+    ~ThreadSlot()
+    {
+        Registry&             reg = registry();
+        const std::lock_guard lock(reg.mutex);
+        for (size_t i = 0; i < NUM_COUNTERS; ++i) {
+            reg.retired[i] +=
+                counters.values[i].load(std::memory_order_relaxed);
+        }
+        std::erase(reg.live, &counters);
+    }
+};
+
+}   // namespace
+
+const char* counter_name(Counter counter)
+{
+    switch (counter) {
+    case Counter::DECODES: return "decodes";
+    case Counter::GENERATIONS: return "generations";
+    case Counter::CROSSOVERS: return "crossovers";
+    case Counter::MUTATIONS: return "mutations";
+    case Counter::ITERATIONS: return "iterations";
+    case Counter::IMPROVEMENTS: return "improvements";
+    case Counter::LOCK_WAIT_NS: return "lock_wait_ns";
+    default: return "unknown";
+    }
+}
+
+ThreadCounters& thread_counters()
+{
+    thread_local ThreadSlot slot;
+    return slot.counters;
+}
+
+CounterValues counter_totals()
+{
+    Registry&             reg = registry();
+    const std::lock_guard lock(reg.mutex);
+    CounterValues         totals = reg.retired;
+    for (const ThreadCounters* counters : reg.live) {
+        for (size_t i = 0; i < NUM_COUNTERS; ++i) {
+            totals[i] += counters->values[i].load(std::memory_order_relaxed);
+        }
+    }
+    return totals;
+}
+
+TelemetryReporter::TelemetryReporter(std::ostream&             out,
+                                     std::chrono::milliseconds interval,
+                                     const Incumbent&          incumbent)
+    : out_(out)
+    , interval_(interval)
+    , incumbent_(incumbent)
+    , start_(Clock::now())
+    , last_time_(start_)
+    , baseline_(counter_totals())
+    , last_(baseline_)
+{
+    thread_ = std::thread([this]() {
+        std::unique_lock lock(mutex_);
+        while (!wake_.wait_for(lock, interval_, [this]() { return stop_; })) {
+            report();
+        }
+    });
+}
+
+TelemetryReporter::~TelemetryReporter()
+{
+    {
+        const std::lock_guard lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_one();
+    thread_.join();
+    report();
+}
+
+void TelemetryReporter::report()
+{
+    using Seconds = std::chrono::duration<double>;
+
+    const auto          now     = Clock::now();
+    const CounterValues totals  = counter_totals();
+    const double        elapsed = Seconds(now - start_).count();
+    const double period = std::max(Seconds(now - last_time_).count(), 1e-9);
+
+    out_ << std::fixed << std::setprecision(3) << "{\"elapsed\": " << elapsed
+         << ", \"makespan\": ";
+    if (incumbent_.snapshot() != nullptr) {
+        out_ << incumbent_.makespan();
+    }
+    else {
+        out_ << "null";
+    }
+    out_ << ", \"lower_bound\": " << incumbent_.lower_bound();
+    for (size_t i = 0; i < NUM_COUNTERS; ++i) {
+        const char* name = counter_name(static_cast<Counter>(i));
+        out_ << ", \"" << name << "\": " << totals[i] - baseline_[i] << ", \""
+             << name << "_per_sec\": " << (totals[i] - last_[i]) / period;
+    }
+    out_ << "}\n" << std::flush;
+
+    last_      = totals;
+    last_time_ = now;
+}
+
+}   // namespace scheduling
@@ -0,0 +1,280 @@
+#include "threadPool.hpp"
+#include "affinity.hpp"
+#include "telemetry.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+
+namespace scheduling {
+
+namespace {
+
+// the pool and worker index of the calling thread
+thread_local const ThreadPool* t_pool   = nullptr;
+thread_local int               t_worker = -1;
+
+std::uint64_t elapsed_ns(std::chrono::steady_clock::time_point since)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now() - since)
+        .count();
+}
+
+}   // namespace
+
+
+ThreadPool::ThreadPool(int num_workers, std::vector<int> cpu_set)
+{
+    num_workers = std::max(1, num_workers);
+    workers_.reserve(num_workers);
+    for (int i = 0; i < num_workers; ++i) {
+        workers_.push_back(std::make_unique<Worker>());
+    }
+
+    threads_.reserve(num_workers);
+    for (int i = 0; i < num_workers; ++i) {
+        int cpu = cpu_set.empty() ? -1 : cpu_set[i % cpu_set.size()];
+        threads_.emplace_back([this, i, cpu]() { worker_loop(i, cpu); });
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(sleep_mtx_);
+        stop_ = true;
+    }
+    sleep_cv_.notify_all();
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+void ThreadPool::submit(Task task)
+{
+    int index = current_worker();
+    if (index < 0) {
+        index = static_cast<int>(next_worker_.fetch_add(1) % workers_.size());
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleep_mtx_);
+        ++pending_;
+    }
+    {
+        std::unique_lock<std::mutex> lock(workers_[index]->mtx,
+                                          std::defer_lock);
+        timed_lock(lock);
+        workers_[index]->tasks.push_back(std::move(task));
+    }
+    sleep_cv_.notify_one();
+}
+
+void ThreadPool::submit_job(Task job)
+{
+    {
+        std::lock_guard<std::mutex> lock(sleep_mtx_);
+        ++pending_;
+    }
+    {
+        std::unique_lock<std::mutex> lock(jobs_mtx_, std::defer_lock);
+        timed_lock(lock);
+        jobs_.push_back(std::move(job));
+    }
+    sleep_cv_.notify_one();
+}
+
+void ThreadPool::parallel_for(size_t                             count,
+                              const std::function<void(size_t)>& body,
+                              size_t                             grain)
+{
+    if (count == 0) {
+        return;
+    }
+    grain = std::max<size_t>(1, grain);
+
+    // shared by the helper jobs, which may start after this call returned
+    struct Range
+    {
+        std::atomic<size_t>                next{0};
+        std::atomic<size_t>                done{0};
+        size_t                             count = 0;
+        size_t                             grain = 1;
+        const std::function<void(size_t)>* body  = nullptr;
+
+        void run()
+        {
+            size_t begin = 0;
+            while ((begin = next.fetch_add(grain)) < count) {
+                size_t end = std::min(begin + grain, count);
+                for (size_t i = begin; i < end; ++i) {
+                    (*body)(i);
+                }
+                done.fetch_add(end - begin, std::memory_order_release);
+            }
+        }
+    };
+
+    auto range   = std::make_shared<Range>();
+    range->count = count;
+    range->grain = grain;
+    range->body  = &body;
+
+    size_t num_chunks  = (count + grain - 1) / grain;
+    size_t num_helpers = std::min(num_chunks - 1, workers_.size());
+    for (size_t i = 0; i < num_helpers; ++i) {
+        submit([range]() { range->run(); });
+    }
+
+    range->run();
+
+    // the remaining chunks are running on other threads, help with other
+    // work of the pool meanwhile
+    const int index = current_worker();
+    while (range->done.load(std::memory_order_acquire) < count) {
+        if (index < 0 || !run_one(index)) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+int ThreadPool::current_worker() const
+{
+    return t_pool == this ? t_worker : -1;
+}
+
+std::vector<ThreadPool::WorkerStats> ThreadPool::stats() const
+{
+    std::vector<WorkerStats> result;
+    result.reserve(workers_.size());
+    for (const auto& worker : workers_) {
+        result.push_back({worker->executed.load(std::memory_order_relaxed),
+                          worker->stolen.load(std::memory_order_relaxed),
+                          worker->busy_ns.load(std::memory_order_relaxed),
+                          worker->idle_ns.load(std::memory_order_relaxed)});
+    }
+    return result;
+}
+
+void ThreadPool::print_stats(std::ostream& out) const
+{
+    const auto worker_stats = stats();
+    for (size_t i = 0; i < worker_stats.size(); ++i) {
+        const auto&  stat  = worker_stats[i];
+        const double total = static_cast<double>(stat.busy_ns + stat.idle_ns);
+        const double utilization =
+            total > 0 ? 100.0 * static_cast<double>(stat.busy_ns) / total : 0;
+        out << "Worker " << i << ": tasks: " << stat.tasks
+            << ", steals: " << stat.steals
+            << ", busy: " << stat.busy_ns / 1000000
+            << " ms, idle: " << stat.idle_ns / 1000000
+            << " ms, utilization: " << utilization << "%\n";
+    }
+}
+
+void ThreadPool::worker_loop(int index, int cpu)
+{
+    t_pool   = this;
+    t_worker = index;
+    if (cpu >= 0) {
+        pin_current_thread(cpu);
+    }
+
+    Worker& worker     = *workers_[index];
+    auto    idle_start = std::chrono::steady_clock::now();
+    while (!stop_.load()) {
+        Task task;
+        if (try_pop(index, task) || try_take_job(task) ||
+            try_steal(index, task)) {
+            worker.idle_ns.fetch_add(elapsed_ns(idle_start),
+                                     std::memory_order_relaxed);
+            auto busy_start = std::chrono::steady_clock::now();
+            task();
+            worker.busy_ns.fetch_add(elapsed_ns(busy_start),
+                                     std::memory_order_relaxed);
+            worker.executed.fetch_add(1, std::memory_order_relaxed);
+            idle_start = std::chrono::steady_clock::now();
+            continue;
+        }
+
+        // nothing to run or steal, sleep until new work is submitted
+        {
+            std::unique_lock<std::mutex> lock(sleep_mtx_);
+            sleep_cv_.wait_for(lock, std::chrono::milliseconds(10), [this]() {
+                return stop_.load() || pending_.load() > 0;
+            });
+        }
+        worker.idle_ns.fetch_add(elapsed_ns(idle_start),
+                                 std::memory_order_relaxed);
+        idle_start = std::chrono::steady_clock::now();
+    }
+    worker.idle_ns.fetch_add(elapsed_ns(idle_start), std::memory_order_relaxed);
+}
+
+bool ThreadPool::try_pop(int index, Task& task)
+{
+    Worker&                      worker = *workers_[index];
+    std::unique_lock<std::mutex> lock(worker.mtx, std::defer_lock);
+    timed_lock(lock);
+    if (worker.tasks.empty()) {
+        return false;
+    }
+    task = std::move(worker.tasks.back());
+    worker.tasks.pop_back();
+    --pending_;
+    return true;
+}
+
+bool ThreadPool::try_steal(int index, Task& task)
+{
+    const size_t num_workers = workers_.size();
+    for (size_t offset = 1; offset < num_workers; ++offset) {
+        Worker& victim = *workers_[(index + offset) % num_workers];
+        std::unique_lock<std::mutex> lock(victim.mtx, std::try_to_lock);
+        if (!lock.owns_lock() || victim.tasks.empty()) {
+            continue;
+        }
+        task = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+        --pending_;
+        workers_[index]->stolen.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+bool ThreadPool::try_take_job(Task& job)
+{
+    std::unique_lock<std::mutex> lock(jobs_mtx_, std::defer_lock);
+    timed_lock(lock);
+    if (jobs_.empty()) {
+        return false;
+    }
+    job = std::move(jobs_.front());
+    jobs_.pop_front();
+    --pending_;
+    return true;
+}
+
+bool ThreadPool::run_one(int index)
+{
+    Task task;
+    if (!try_pop(index, task) && !try_steal(index, task)) {
+        return false;
+    }
+    // runs inside a task of this worker, its time is already counted as busy
+    task();
+    workers_[index]->executed.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+}   // namespace scheduling
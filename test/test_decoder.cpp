@@ -0,0 +1,362 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "algorithm.hpp"
+#include "batchDecoder.hpp"
+#include "compiledInstance.hpp"
+#include "decoder.hpp"
+#include "incumbent.hpp"
+#include "jobShopInstance.hpp"
+#include "random.hpp"
+#include "threadPool.hpp"
+
+TEST(DecoderTest, CompiledInstanceLayout)
+{
+    scheduling::JobShopInstance instance;
+    instance.generate_instance(6, 4);
+
+    scheduling::CompiledInstance compiled(instance);
+    EXPECT_EQ(compiled.num_jobs(), 6);
+    EXPECT_EQ(compiled.num_machines(), 4);
+    EXPECT_EQ(compiled.num_ops(), 24);
+    EXPECT_EQ(compiled.job_offsets().size(), 7);
+
+    // operations of each job follow the step order of the instance
+    for (const auto& [job_id, job] : instance.jobs()) {
+        auto op = compiled.job_begin(compiled.job_index(job_id));
+        for (const auto& [step_id, step] : job.steps) {
+            EXPECT_EQ(compiled.machine_ids()[compiled.op_machines()[op]],
+                      step.machine_id);
+            EXPECT_EQ(compiled.op_durations()[op], step.duration);
+            EXPECT_EQ(compiled.op_steps()[op], step_id);
+            ++op;
+        }
+    }
+
+    // every operation is listed once, on its own machine
+    size_t num_listed = 0;
+    for (scheduling::MachineID machine = 0; machine < 4; ++machine) {
+        for (auto op : compiled.machine_ops(machine)) {
+            EXPECT_EQ(compiled.op_machines()[op], machine);
+            ++num_listed;
+        }
+    }
+    EXPECT_EQ(num_listed, compiled.num_ops());
+}
+
+TEST(DecoderTest, MakespanMatchesFullDecode)
+{
+    scheduling::JobShopInstance instance;
+    instance.generate_instance(10, 5);
+    scheduling::CompiledInstance compiled(instance);
+
+    for (int i = 0; i < 20; i++) {
+        auto individual = scheduling::GAAlgorithm::encode(compiled);
+        auto solution =
+            scheduling::GAAlgorithm::decode(individual.chromosome, instance);
+        EXPECT_EQ(individual.fitness, solution.makespan);
+        EXPECT_EQ(scheduling::decode_makespan(individual.chromosome, compiled),
+                  solution.makespan);
+    }
+}
+
+TEST(DecoderTest, FixedShapesMatchGenericDecode)
+{
+    // shapes with a specialized kernel, and ones without
+    const std::vector<std::pair<int, int>> shapes{
+        {6, 6}, {10, 5}, {12, 10}, {30, 15}, {25, 20}, {7, 8}, {4, 12},
+        {130, 5}};
+
+    for (auto [num_jobs, num_machines] : shapes) {
+        scheduling::JobShopInstance instance;
+        instance.generate_instance(num_jobs, num_machines);
+        scheduling::CompiledInstance compiled(instance);
+        EXPECT_EQ(compiled.ops_per_job(), num_machines);
+        EXPECT_EQ(scheduling::has_fixed_shape_decoder(compiled),
+                  num_jobs <= 128 &&
+                      (num_machines == 5 || num_machines == 6 ||
+                       num_machines == 10 || num_machines == 15 ||
+                       num_machines == 20));
+
+        for (int i = 0; i < 20; i++) {
+            auto individual = scheduling::GAAlgorithm::encode(compiled);
+            EXPECT_EQ(scheduling::decode_makespan(individual.chromosome,
+                                                  compiled),
+                      scheduling::decode_makespan_generic(
+                          individual.chromosome, compiled));
+            EXPECT_EQ(individual.fitness,
+                      scheduling::GAAlgorithm::decode(individual.chromosome,
+                                                      compiled)
+                          .makespan);
+        }
+    }
+
+    // jobs of different lengths have no fixed shape
+    scheduling::JobShopInstance instance;
+    instance.generate_instance(5, 5);
+    instance.add_step(0, 5, 0, 3);
+    EXPECT_EQ(scheduling::CompiledInstance(instance).ops_per_job(), 0);
+}
+
+TEST(DecoderTest, FlatSolutionLayout)
+{
+    scheduling::JobShopInstance instance;
+    instance.generate_instance(6, 4);
+    scheduling::CompiledInstance compiled(instance);
+
+    auto individual = scheduling::GAAlgorithm::encode(compiled);
+    auto solution =
+        scheduling::GAAlgorithm::decode(individual.chromosome, compiled);
+    ASSERT_EQ(solution.num_ops(), compiled.num_ops());
+    ASSERT_EQ(solution.num_machines(), compiled.num_machines());
+
+    for (scheduling::OpID op = 0; op < solution.num_ops(); ++op) {
+        EXPECT_EQ(solution.end_times[op] - solution.start_times[op],
+                  compiled.op_durations()[op]);
+        EXPECT_EQ(solution.job_ids[op],
+                  compiled.job_ids()[compiled.op_jobs()[op]]);
+    }
+    for (scheduling::MachineID machine = 0; machine < solution.num_machines();
+         ++machine) {
+        scheduling::TimeStamp last_end = 0;
+        for (scheduling::OpID op : solution.machine_sequence(machine)) {
+            EXPECT_EQ(compiled.op_machines()[op], machine);
+            EXPECT_GE(solution.start_times[op], last_end);
+            last_end = solution.end_times[op];
+        }
+    }
+
+    // copies share nothing, and encode back to the same schedule
+    const scheduling::Solution copy = solution;
+    solution.start_times.assign(solution.num_ops(), 0);
+    EXPECT_EQ(scheduling::decode_makespan(
+                  scheduling::GAAlgorithm::encode(copy).chromosome, compiled),
+              individual.fitness);
+}
+
+TEST(DecoderTest, IncrementalMatchesFullDecode)
+{
+    scheduling::JobShopInstance instance;
+    instance.generate_instance(8, 6);
+    scheduling::CompiledInstance compiled(instance);
+
+    std::mt19937 rng(42);
+    for (size_t interval : {1, 5, 0}) {
+        scheduling::IncrementalDecoder decoder(interval);
+        auto base = scheduling::GAAlgorithm::encode(compiled).chromosome;
+        EXPECT_EQ(decoder.reset(base, compiled),
+                  scheduling::decode_makespan(base, compiled));
+
+        std::uniform_int_distribution<size_t> dist(0, base.size() - 1);
+        for (int i = 0; i < 200; i++) {
+            auto   candidate = base;
+            size_t pos_1     = dist(rng);
+            size_t pos_2     = dist(rng);
+            std::swap(candidate[pos_1], candidate[pos_2]);
+            EXPECT_EQ(decoder.evaluate(candidate,
+                                       std::min(pos_1, pos_2),
+                                       std::max(pos_1, pos_2)),
+                      scheduling::decode_makespan(candidate, compiled));
+        }
+    }
+}
+
+TEST(DecoderTest, BatchMatchesScalarDecode)
+{
+    scheduling::JobShopInstance instance;
+    instance.generate_instance(12, 7);
+    scheduling::CompiledInstance compiled(instance);
+
+    // 37 chromosomes: full batches and a partial one for every lane count
+    std::vector<scheduling::Chromosome>         population;
+    std::vector<scheduling::ConstChromosomeRef> chromosomes;
+    for (int i = 0; i < 37; i++) {
+        population.push_back(
+            scheduling::GAAlgorithm::encode(compiled).chromosome);
+    }
+    for (const auto& chromosome : population) {
+        chromosomes.emplace_back(chromosome);
+    }
+
+    for (auto isa : {scheduling::DecodeIsa::SCALAR,
+                     scheduling::DecodeIsa::AVX2,
+                     scheduling::DecodeIsa::AVX512}) {
+        if (!scheduling::decode_isa_supported(isa)) {
+            continue;
+        }
+        std::vector<scheduling::Fitness> makespans(chromosomes.size());
+        scheduling::decode_makespan_batch(
+            chromosomes, compiled, makespans, isa);
+        for (size_t i = 0; i < chromosomes.size(); i++) {
+            EXPECT_EQ(makespans[i],
+                      scheduling::decode_makespan(population[i], compiled))
+                << scheduling::decode_isa_name(isa) << " chromosome " << i;
+        }
+    }
+    EXPECT_TRUE(scheduling::decode_isa_supported(scheduling::decode_isa()));
+    EXPECT_TRUE(scheduling::decode_isa_supported(
+        scheduling::fastest_decode_isa(compiled)));
+}
+
+TEST(DecoderTest, ScheduleModesAreFeasible)
+{
+    scheduling::JobShopInstance instance;
+    instance.generate_instance(10, 6);
+    scheduling::CompiledInstance compiled(instance);
+
+    const std::vector<std::pair<scheduling::DecodeMode, double>> modes{
+        {scheduling::DecodeMode::SEMI_ACTIVE, 1.0},
+        {scheduling::DecodeMode::ACTIVE, 1.0},
+        {scheduling::DecodeMode::GIFFLER_THOMPSON, 0.0},
+        {scheduling::DecodeMode::GIFFLER_THOMPSON, 0.5},
+        {scheduling::DecodeMode::GIFFLER_THOMPSON, 1.0}};
+
+    for (int i = 0; i < 20; i++) {
+        auto chromosome = scheduling::GAAlgorithm::encode(compiled).chromosome;
+        const auto semi_active =
+            scheduling::decode_makespan(chromosome, compiled);
+
+        for (auto [mode, delay] : modes) {
+            std::vector<scheduling::TimeStamp> start_times(compiled.num_ops());
+            const auto makespan = scheduling::decode_schedule(
+                chromosome, compiled, mode, delay, start_times);
+            EXPECT_EQ(makespan,
+                      scheduling::decode_schedule(
+                          chromosome, compiled, mode, delay));
+            if (mode == scheduling::DecodeMode::ACTIVE) {
+                EXPECT_LE(makespan, semi_active);
+            }
+
+            // jobs in order, machines never run two operations at once
+            scheduling::TimeStamp last_end = 0;
+            for (scheduling::OpID op = 0; op < compiled.num_ops(); ++op) {
+                const auto end = start_times[op] + compiled.op_durations()[op];
+                last_end       = std::max(last_end, end);
+                if (op + 1 < compiled.num_ops() &&
+                    compiled.op_jobs()[op + 1] == compiled.op_jobs()[op]) {
+                    EXPECT_GE(start_times[op + 1], end);
+                }
+            }
+            EXPECT_EQ(last_end, makespan);
+            for (scheduling::MachineID machine = 0;
+                 machine < compiled.num_machines();
+                 ++machine) {
+                auto ops = compiled.machine_ops(machine);
+                std::vector<scheduling::OpID> sequence(ops.begin(), ops.end());
+                std::ranges::sort(sequence, {}, [&](scheduling::OpID op) {
+                    return start_times[op];
+                });
+                for (size_t k = 1; k < sequence.size(); ++k) {
+                    EXPECT_GE(start_times[sequence[k]],
+                              start_times[sequence[k - 1]] +
+                                  compiled.op_durations()[sequence[k - 1]]);
+                }
+            }
+
+            // the solution of the mode has the decoded makespan
+            EXPECT_EQ(scheduling::GAAlgorithm::decode(
+                          chromosome, compiled, mode, delay)
+                          .makespan,
+                      makespan);
+        }
+    }
+}
+
+TEST(DecoderTest, ParseDecodeMode)
+{
+    for (auto mode : {scheduling::DecodeMode::SEMI_ACTIVE,
+                      scheduling::DecodeMode::ACTIVE,
+                      scheduling::DecodeMode::GIFFLER_THOMPSON}) {
+        EXPECT_EQ(scheduling::parse_decode_mode(
+                      scheduling::decode_mode_name(mode)),
+                  mode);
+    }
+    EXPECT_THROW(scheduling::parse_decode_mode("non_delay_ish"),
+                 std::invalid_argument);
+}
+
+TEST(DecoderTest, GAPublishesSchedulesOfItsDecodeMode)
+{
+    scheduling::JobShopInstance instance;
+    instance.generate_instance(10, 5);
+    scheduling::CompiledInstance compiled(instance);
+
+    for (auto mode : {scheduling::DecodeMode::ACTIVE,
+                      scheduling::DecodeMode::GIFFLER_THOMPSON}) {
+        scheduling::Incumbent   incumbent;
+        scheduling::GAAlgorithm ga(2, 1, 50);
+        ga.set_decode_mode(mode, 0.5);
+        ga.solve(compiled, incumbent);
+
+        // the published chromosome decodes semi-actively to the schedule
+        auto best = incumbent.snapshot();
+        ASSERT_NE(best, nullptr);
+        EXPECT_EQ(best->makespan, incumbent.makespan());
+        EXPECT_EQ(scheduling::decode_makespan(best->chromo, compiled),
+                  incumbent.makespan());
+    }
+}
+
+TEST(DecoderTest, GAPopulationsAreReproducibleOnThePool)
+{
+    scheduling::JobShopInstance instance;
+    instance.generate_instance(10, 5);
+    scheduling::CompiledInstance compiled(instance);
+
+    // more pool workers than islands, so the tasks of the generations are
+    // stolen by whichever worker is idle
+    auto run = [&]() {
+        scheduling::set_master_seed(42);
+        scheduling::ThreadPool  pool(3);
+        scheduling::Incumbent   incumbent;
+        scheduling::GAAlgorithm ga(2, 60, 40);
+        ga.set_thread_pool(&pool);
+        ga.set_migration(scheduling::GAAlgorithm::Topology::RING, 0, 0);
+        ga.set_generation_limit(20);
+        ga.solve(compiled, incumbent);
+        return ga.populations();
+    };
+
+    const auto first  = run();
+    const auto second = run();
+    ASSERT_EQ(first.size(), 2);
+    ASSERT_EQ(second.size(), 2);
+    for (size_t island = 0; island < first.size(); island++) {
+        ASSERT_EQ(first[island].size(), second[island].size());
+        for (size_t i = 0; i < first[island].size(); i++) {
+            EXPECT_EQ(first[island][i].chromosome,
+                      second[island][i].chromosome);
+            EXPECT_EQ(first[island][i].fitness, second[island][i].fitness);
+        }
+    }
+}
+
+TEST(DecoderTest, GAGenerationsSpreadOverThePool)
+{
+    scheduling::JobShopInstance instance;
+    instance.generate_instance(20, 10);
+    scheduling::CompiledInstance compiled(instance);
+
+    // one island keeps one worker of the pool, the decode and mutation
+    // tasks of its generations are run by the other workers too
+    scheduling::ThreadPool  pool(3);
+    scheduling::Incumbent   incumbent;
+    scheduling::GAAlgorithm ga(1, 60, 100);
+    ga.set_thread_pool(&pool);
+    ga.set_generation_limit(30);
+    ga.solve(compiled, incumbent);
+
+    // the tasks go to the island's worker, the others steal theirs
+    int helping_workers = 0;
+    for (const auto& stat : pool.stats()) {
+        if (stat.steals > 0) {
+            helping_workers++;
+        }
+    }
+    EXPECT_GE(helping_workers, 1);
+}
@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include "algorithm.hpp"
+#include "compiledInstance.hpp"
+#include "decoder.hpp"
+#include "disjunctiveGraph.hpp"
+#include "jobShopInstance.hpp"
+
+TEST(DisjunctiveGraphTest, HeadsTailsMatchDecoder)
+{
+    scheduling::JobShopInstance instance;
+    instance.generate_instance(10, 6);
+    scheduling::CompiledInstance compiled(instance);
+
+    for (int i = 0; i < 10; i++) {
+        auto individual = scheduling::GAAlgorithm::encode(compiled);
+        auto graph      = scheduling::DisjunctiveGraph::from_chromosome(
+            individual.chromosome, compiled);
+        EXPECT_EQ(graph.makespan(), individual.fitness);
+
+        // heads and tails bound the makespan, and are tight somewhere
+        scheduling::TimeStamp longest = 0;
+        for (scheduling::OpID op = 0; op < graph.num_ops(); op++) {
+            auto length = graph.head(op) + graph.duration(op) + graph.tail(op);
+            EXPECT_LE(length, graph.makespan());
+            longest = std::max(longest, length);
+        }
+        EXPECT_EQ(longest, graph.makespan());
+
+        // the chromosome of the graph decodes to the same schedule
+        auto chromosome = graph.to_chromosome();
+        EXPECT_EQ(scheduling::decode_makespan(chromosome, compiled),
+                  graph.makespan());
+
+        // converting through a Solution keeps the machine sequences
+        auto solution = graph.to_solution();
+        auto copy =
+            scheduling::DisjunctiveGraph::from_solution(solution, compiled);
+        EXPECT_EQ(copy.makespan(), graph.makespan());
+        for (scheduling::MachineID machine = 0; machine < 6; machine++) {
+            auto lhs = graph.machine_sequence(machine);
+            auto rhs = copy.machine_sequence(machine);
+            EXPECT_TRUE(std::equal(lhs.begin(), lhs.end(), rhs.begin()));
+        }
+    }
+}
+
+TEST(DisjunctiveGraphTest, CriticalPathAndBlocks)
+{
+    scheduling::JobShopInstance instance;
+    instance.generate_instance(8, 5);
+    scheduling::CompiledInstance compiled(instance);
+
+    auto graph = scheduling::DisjunctiveGraph::from_chromosome(
+        scheduling::GAAlgorithm::encode(compiled).chromosome, compiled);
+
+    // the critical path has no idle time, its length is the makespan
+    auto                  path   = graph.critical_path();
+    scheduling::TimeStamp length = 0;
+    for (auto op : path) {
+        EXPECT_EQ(graph.head(op), length);
+        length += graph.duration(op);
+    }
+    EXPECT_EQ(length, graph.makespan());
+
+    // the blocks cover the path, each on consecutive machine positions
+    size_t num_path_ops = 0;
+    for (const auto& block : graph.critical_blocks()) {
+        auto sequence = graph.machine_sequence(block.machine);
+        for (size_t pos = block.begin; pos < block.end; pos++) {
+            EXPECT_EQ(sequence[pos], path[num_path_ops]);
+            num_path_ops++;
+        }
+    }
+    EXPECT_EQ(num_path_ops, path.size());
+}
+
+TEST(DisjunctiveGraphTest, MoveOnMachineKeepsArcsConsistent)
+{
+    scheduling::JobShopInstance instance;
+    instance.generate_instance(6, 4);
+    scheduling::CompiledInstance compiled(instance);
+
+    auto graph = scheduling::DisjunctiveGraph::from_chromosome(
+        scheduling::GAAlgorithm::encode(compiled).chromosome, compiled);
+
+    graph.move_on_machine(0, 0, 4);
+    graph.move_on_machine(1, 5, 1);
+    graph.move_on_machine(2, 2, 3);
+    for (scheduling::MachineID machine = 0; machine < 4; machine++) {
+        auto sequence = graph.machine_sequence(machine);
+        for (size_t pos = 0; pos < sequence.size(); pos++) {
+            EXPECT_EQ(graph.machine_position(sequence[pos]), pos);
+            EXPECT_EQ(graph.machine_pred(sequence[pos]),
+                      pos > 0 ? sequence[pos - 1]
+                              : scheduling::DisjunctiveGraph::NONE);
+        }
+    }
+
+    // a feasible graph matches the decode of its own chromosome
+    if (graph.update()) {
+        EXPECT_EQ(scheduling::decode_makespan(graph.to_chromosome(), compiled),
+                  graph.makespan());
+    }
+}
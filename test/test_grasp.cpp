@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+
+#include "compiledInstance.hpp"
+#include "decoder.hpp"
+#include "disjunctiveGraph.hpp"
+#include "grasp.hpp"
+#include "incumbent.hpp"
+#include "jobShopInstance.hpp"
+#include "random.hpp"
+#include "threadPool.hpp"
+
+TEST(GraspTest, LocalSearchNeverWorsens)
+{
+    scheduling::JobShopInstance instance;
+    instance.generate_instance(15, 5);
+    scheduling::CompiledInstance compiled(instance);
+
+    for (int i = 0; i < 10; i++) {
+        auto graph = scheduling::DisjunctiveGraph::from_chromosome(
+            scheduling::GAAlgorithm::encode(compiled).chromosome, compiled);
+        auto before = graph.makespan();
+        scheduling::GraspAlgorithm::local_search(graph);
+        EXPECT_LE(graph.makespan(), before);
+        EXPECT_EQ(scheduling::decode_makespan(graph.to_chromosome(), compiled),
+                  graph.makespan());
+    }
+}
+
+TEST(GraspTest, EliteSeedsAreSortedAndDistinct)
+{
+    scheduling::JobShopInstance instance;
+    instance.generate_instance(10, 5);
+    scheduling::CompiledInstance compiled(instance);
+
+    scheduling::Incumbent      incumbent;
+    scheduling::GraspAlgorithm  grasp(2, 10, 50, 5);
+    grasp.solve(compiled, incumbent);
+
+    auto elite = grasp.elite();
+    ASSERT_FALSE(elite.empty());
+    EXPECT_LE(elite.size(), 5);
+    EXPECT_EQ(elite.front().fitness, incumbent.makespan());
+    for (size_t i = 0; i < elite.size(); i++) {
+        EXPECT_EQ(scheduling::decode_makespan(elite[i].chromosome, compiled),
+                  elite[i].fitness);
+        for (size_t j = 0; j < i; j++) {
+            EXPECT_LE(elite[j].fitness, elite[i].fitness);
+            EXPECT_NE(elite[j].chromosome, elite[i].chromosome);
+        }
+    }
+}
+
+TEST(GraspTest, EliteIsReproducibleOnThePool)
+{
+    scheduling::JobShopInstance instance;
+    instance.generate_instance(10, 5);
+    scheduling::CompiledInstance compiled(instance);
+
+    // the starts are stolen by whichever worker of the pool is idle
+    auto run = [&]() {
+        scheduling::set_master_seed(7);
+        scheduling::ThreadPool     pool(3);
+        scheduling::Incumbent      incumbent;
+        scheduling::GraspAlgorithm grasp(3, 60, 50, 5);
+        grasp.set_thread_pool(&pool);
+        grasp.solve(compiled, incumbent);
+        return grasp.elite();
+    };
+
+    const auto first  = run();
+    const auto second = run();
+    ASSERT_EQ(first.size(), second.size());
+    for (size_t i = 0; i < first.size(); i++) {
+        EXPECT_EQ(first[i].chromosome, second[i].chromosome);
+        EXPECT_EQ(first[i].fitness, second[i].fitness);
+    }
+}
@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "incumbent.hpp"
+#include "solution.hpp"
+
+namespace {
+
+scheduling::Solution make_solution(scheduling::Fitness makespan)
+{
+    scheduling::Solution solution;
+    solution.makespan = makespan;
+    return solution;
+}
+
+}   // namespace
+
+TEST(IncumbentTest, PublishesOnlyImprovements)
+{
+    scheduling::Incumbent incumbent(make_solution(100));
+    EXPECT_EQ(incumbent.makespan(), 100);
+    EXPECT_EQ(incumbent.epoch(), 1);
+
+    EXPECT_FALSE(incumbent.publish(make_solution(120)));
+    EXPECT_FALSE(incumbent.publish(make_solution(100)));
+
+    bool built = false;
+    EXPECT_FALSE(incumbent.try_publish(110, [&]() {
+        built = true;
+        return make_solution(110);
+    }));
+    EXPECT_FALSE(built);
+
+    auto old_snapshot = incumbent.snapshot();
+    EXPECT_TRUE(incumbent.try_publish(90, [&]() { return make_solution(90); }));
+    EXPECT_EQ(incumbent.makespan(), 90);
+    EXPECT_EQ(incumbent.snapshot()->makespan, 90);
+    EXPECT_EQ(incumbent.epoch(), 2);
+
+    // readers keep their snapshot alive
+    EXPECT_EQ(old_snapshot->makespan, 100);
+}
+
+TEST(IncumbentTest, ConcurrentPublishersKeepTheBest)
+{
+    scheduling::Incumbent incumbent;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([t, &incumbent]() {
+            for (scheduling::Fitness makespan = 1000 + t; makespan > 10;
+                 makespan -= 4) {
+                incumbent.try_publish(
+                    makespan, [=]() { return make_solution(makespan); });
+                EXPECT_LE(incumbent.snapshot()->makespan, 1003);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(incumbent.makespan(), 11);
+    EXPECT_EQ(incumbent.snapshot()->makespan, 11);
+}
+
+TEST(IncumbentTest, LowerBoundClosesTheGap)
+{
+    scheduling::Incumbent incumbent(make_solution(100));
+    EXPECT_EQ(incumbent.lower_bound(), 0);
+    EXPECT_FALSE(incumbent.gap_closed());
+
+    // the bound only goes up
+    EXPECT_TRUE(incumbent.raise_lower_bound(80));
+    EXPECT_FALSE(incumbent.raise_lower_bound(70));
+    EXPECT_EQ(incumbent.lower_bound(), 80);
+    EXPECT_FALSE(incumbent.gap_closed());
+
+    incumbent.publish(make_solution(80));
+    EXPECT_TRUE(incumbent.gap_closed());
+}
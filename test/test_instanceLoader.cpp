@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include "compiledInstance.hpp"
+#include "instanceLoader.hpp"
+#include "jobShopInstance.hpp"
+
+namespace {
+
+std::string write_file(const std::string& name, const std::string& content)
+{
+    auto path = std::filesystem::temp_directory_path() / name;
+    std::ofstream(path) << content;
+    return path.string();
+}
+
+}   // namespace
+
+TEST(InstanceLoaderTest, OrLibrary)
+{
+    // ft06, with a name and a comment line before the header
+    auto path = write_file("ft06.txt",
+                           " instance ft06\n"
+                           " +++ Fisher and Thompson 6x6 instance\n"
+                           " 6 6\n"
+                           " 2  1  0  3  1  6  3  7  5  3  4  6\n"
+                           " 1  8  2  5  4 10  5 10  0 10  3  4\n"
+                           " 2  5  3  4  5  8  0  9  1  1  4  7\n"
+                           " 1  5  0  5  2  5  3  3  4  8  5  9\n"
+                           " 2  9  1  3  4  5  5  4  0  3  3  1\n"
+                           " 1  3  3  3  5  9  0 10  4  4  2  1\n");
+    scheduling::JobShopInstance instance;
+    scheduling::load_instance(path, instance);
+
+    EXPECT_EQ(instance.jobs().size(), 6);
+    EXPECT_EQ(instance.machines().size(), 6);
+    const auto& step = instance.jobs().at(1).steps.at(2);
+    EXPECT_EQ(step.machine_id, 4);
+    EXPECT_EQ(step.duration, 10);
+
+    scheduling::CompiledInstance compiled(instance);
+    EXPECT_EQ(compiled.total_duration(), 197);
+}
+
+TEST(InstanceLoaderTest, Taillard)
+{
+    auto path = write_file(
+        "ta_small.txt",
+        "Nb of jobs, Nb of Machines, Time seed, Machine seed, Upper bound, "
+        "Lower bound\n"
+        "           2           3   840612802   398197754        1231   1005\n"
+        "Times\n"
+        " 54 34 61\n"
+        " 83 77 94\n"
+        "Machines\n"
+        " 1 3 2\n"
+        " 3 2 1\n");
+    scheduling::JobShopInstance instance;
+    scheduling::load_instance(path, instance);
+
+    EXPECT_EQ(instance.jobs().size(), 2);
+    EXPECT_EQ(instance.machines().size(), 3);
+    EXPECT_EQ(instance.jobs().at(0).steps.at(1).machine_id, 2);
+    EXPECT_EQ(instance.jobs().at(0).steps.at(1).duration, 34);
+    EXPECT_EQ(instance.jobs().at(1).steps.at(2).machine_id, 0);
+}
+
+TEST(InstanceLoaderTest, Json)
+{
+    auto path = write_file(
+        "small.json",
+        R"({"name": "small", "tags": ["a", {"b": [1, 2]}],
+            "jobs": [
+              {"id": 1, "due_date": 40, "steps": [
+                {"machine": 1, "duration": 5}, {"duration": 3, "machine": 0}]},
+              {"id": 0, "steps": [
+                {"machine": 0, "duration": 2, "note": "x\"y"}]}
+            ]})");
+    scheduling::JobShopInstance instance;
+    scheduling::load_instance(path, instance);
+
+    EXPECT_EQ(instance.jobs().size(), 2);
+    EXPECT_EQ(instance.machines().size(), 2);
+    EXPECT_EQ(instance.jobs().at(1).due_date, 40);
+    EXPECT_EQ(instance.jobs().at(1).steps.at(1).machine_id, 0);
+    EXPECT_EQ(instance.jobs().at(1).steps.at(1).duration, 3);
+    EXPECT_EQ(instance.jobs().at(0).steps.size(), 1);
+}
+
+TEST(InstanceLoaderTest, MalformedInput)
+{
+    scheduling::JobShopInstance instance;
+    EXPECT_THROW(scheduling::load_instance("/nonexistent/instance", instance),
+                 std::runtime_error);
+
+    auto truncated = write_file("truncated.txt", "2 2\n0 1 1 2\n0 3\n");
+    EXPECT_THROW(scheduling::load_instance(truncated, instance),
+                 std::runtime_error);
+
+    auto bad_json = write_file("bad.json", R"({"jobs": [{"steps": [}]})");
+    EXPECT_THROW(scheduling::load_instance(bad_json, instance),
+                 std::runtime_error);
+}
+
+TEST(InstanceLoaderTest, BadHeadersAndIds)
+{
+    scheduling::JobShopInstance instance;
+
+    // headers larger than the file, empty, or overflowing the operations
+    for (const char* header :
+         {"3 2\n0 1 1 2\n0 3 1 4\n", "0 0\n", "0 5\n",
+          "4294967295 4294967295\n0 1\n"}) {
+        auto path = write_file("bad_header.txt", header);
+        EXPECT_THROW(scheduling::load_instance(path, instance),
+                     std::runtime_error)
+            << header;
+    }
+    auto taillard = write_file(
+        "bad_header_ta.txt",
+        "Nb of jobs, Nb of Machines\n100000 100000\nTimes\n1 2\n"
+        "Machines\n1 2\n");
+    EXPECT_THROW(scheduling::load_instance(taillard, instance),
+                 std::runtime_error);
+
+    // duplicate jobs, ids past the number of jobs or machines, a machine
+    // visited twice by a job
+    for (const char* jobs :
+         {R"({"jobs": [{"id": 0, "steps": [{"machine": 0, "duration": 1}]},
+                       {"id": 0, "steps": [{"machine": 0, "duration": 1}]}]})",
+          R"({"jobs": [{"id": 4000000000,
+                        "steps": [{"machine": 0, "duration": 1}]}]})",
+          R"({"jobs": [{"steps": [{"machine": 9, "duration": 1}]}]})",
+          R"({"jobs": [{"steps": [{"machine": 0, "duration": 1},
+                                  {"machine": 0, "duration": 2}]}]})"}) {
+        auto path = write_file("bad_ids.json", jobs);
+        EXPECT_THROW(scheduling::load_instance(path, instance),
+                     std::runtime_error)
+            << jobs;
+    }
+}
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "algorithm.hpp"
+#include "compiledInstance.hpp"
+#include "decoder.hpp"
+#include "disjunctiveGraph.hpp"
+#include "jobShopInstance.hpp"
+#include "lns.hpp"
+
+TEST(LnsTest, RelaxationsPickOperations)
+{
+    scheduling::JobShopInstance instance;
+    instance.generate_instance(10, 5);
+    scheduling::CompiledInstance compiled(instance);
+
+    auto graph = scheduling::DisjunctiveGraph::from_chromosome(
+        scheduling::GAAlgorithm::encode(compiled).chromosome, compiled);
+
+    std::vector<char> relaxed;
+    for (auto relaxation : {scheduling::LnsAlgorithm::Relaxation::TIME_WINDOW,
+                            scheduling::LnsAlgorithm::Relaxation::MACHINES,
+                            scheduling::LnsAlgorithm::Relaxation::JOBS}) {
+        scheduling::LnsAlgorithm::relax(graph, relaxation, 0.2, relaxed);
+        EXPECT_EQ(relaxed.size(), graph.num_ops());
+        EXPECT_GT(std::count(relaxed.begin(), relaxed.end(), 1), 0);
+    }
+
+    // 2 of the 10 jobs
+    scheduling::LnsAlgorithm::relax(
+        graph, scheduling::LnsAlgorithm::Relaxation::JOBS, 0.2, relaxed);
+    EXPECT_EQ(std::count(relaxed.begin(), relaxed.end(), 1), 10);
+}
+
+TEST(LnsTest, DispatchingRepairKeepsFixedOrder)
+{
+    scheduling::JobShopInstance instance;
+    instance.generate_instance(10, 5);
+    scheduling::CompiledInstance compiled(instance);
+
+    auto graph = scheduling::DisjunctiveGraph::from_chromosome(
+        scheduling::GAAlgorithm::encode(compiled).chromosome, compiled);
+
+    // nothing relaxed: the same machine sequences
+    std::vector<char> relaxed(graph.num_ops(), 0);
+    auto repaired =
+        scheduling::LnsAlgorithm::repair_with_dispatching(graph, relaxed);
+    EXPECT_EQ(repaired.makespan(), graph.makespan());
+
+    for (int i = 0; i < 10; i++) {
+        scheduling::LnsAlgorithm::relax(
+            graph, scheduling::LnsAlgorithm::Relaxation::MACHINES, 0.4,
+            relaxed);
+        repaired =
+            scheduling::LnsAlgorithm::repair_with_dispatching(graph, relaxed);
+
+        // a feasible schedule, where the other machines are unchanged
+        EXPECT_EQ(
+            scheduling::decode_makespan(repaired.to_chromosome(), compiled),
+            repaired.makespan());
+        for (scheduling::MachineID machine = 0; machine < 5; machine++) {
+            auto ops = compiled.machine_ops(machine);
+            if (relaxed[ops[0]]) {
+                continue;
+            }
+            auto lhs = graph.machine_sequence(machine);
+            auto rhs = repaired.machine_sequence(machine);
+            EXPECT_TRUE(std::equal(lhs.begin(), lhs.end(), rhs.begin()));
+        }
+    }
+}
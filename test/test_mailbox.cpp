@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "algorithm.hpp"
+#include "compiledInstance.hpp"
+#include "decoder.hpp"
+#include "incumbent.hpp"
+#include "jobShopInstance.hpp"
+#include "mailbox.hpp"
+
+TEST(MailboxTest, PopsInPushOrder)
+{
+    scheduling::SpscMailbox<int> mailbox(4);
+
+    int item = 0;
+    EXPECT_FALSE(mailbox.try_pop(item));
+    for (int round = 0; round < 3; round++) {
+        EXPECT_TRUE(mailbox.try_push(1));
+        EXPECT_TRUE(mailbox.try_push(2));
+        EXPECT_TRUE(mailbox.try_pop(item));
+        EXPECT_EQ(item, 1);
+        EXPECT_TRUE(mailbox.try_pop(item));
+        EXPECT_EQ(item, 2);
+        EXPECT_FALSE(mailbox.try_pop(item));
+    }
+}
+
+TEST(MailboxTest, DropsWhenFull)
+{
+    scheduling::SpscMailbox<int> mailbox(3);
+    EXPECT_EQ(mailbox.capacity(), 3);
+
+    EXPECT_TRUE(mailbox.try_push(1));
+    EXPECT_TRUE(mailbox.try_push(2));
+    EXPECT_TRUE(mailbox.try_push(3));
+    EXPECT_FALSE(mailbox.try_push(4));
+
+    int item = 0;
+    EXPECT_TRUE(mailbox.try_pop(item));
+    EXPECT_EQ(item, 1);
+    EXPECT_TRUE(mailbox.try_push(5));
+    for (int expected : {2, 3, 5}) {
+        EXPECT_TRUE(mailbox.try_pop(item));
+        EXPECT_EQ(item, expected);
+    }
+    EXPECT_FALSE(mailbox.try_pop(item));
+}
+
+TEST(MailboxTest, TransfersBetweenThreads)
+{
+    constexpr int                             COUNT = 100000;
+    scheduling::SpscMailbox<std::vector<int>> mailbox(8);
+
+    std::thread producer([&]() {
+        for (int i = 0; i < COUNT; i++) {
+            while (!mailbox.try_push(std::vector<int>{i, i})) {
+            }
+        }
+    });
+
+    std::vector<int> item;
+    for (int expected = 0; expected < COUNT; expected++) {
+        while (!mailbox.try_pop(item)) {
+        }
+        ASSERT_EQ(item, (std::vector<int>{expected, expected}));
+    }
+    producer.join();
+}
+
+TEST(MailboxTest, IslandGAPublishesValidSchedules)
+{
+    scheduling::JobShopInstance instance;
+    instance.generate_instance(10, 5);
+    scheduling::CompiledInstance compiled(instance);
+
+    for (auto topology : {scheduling::GAAlgorithm::Topology::RING,
+                          scheduling::GAAlgorithm::Topology::RANDOM}) {
+        scheduling::Incumbent   incumbent;
+        scheduling::GAAlgorithm ga(3, 1, 50);
+        ga.set_migration(topology, 2, 2);
+        ga.solve(compiled, incumbent);
+
+        auto best = incumbent.snapshot();
+        ASSERT_NE(best, nullptr);
+        EXPECT_EQ(best->makespan, incumbent.makespan());
+        EXPECT_EQ(scheduling::decode_makespan(best->chromo, compiled),
+                  incumbent.makespan());
+    }
+}
@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "algorithm.hpp"
+#include "compiledInstance.hpp"
+#include "decoder.hpp"
+#include "incumbent.hpp"
+#include "jobShopInstance.hpp"
+#include "populationArena.hpp"
+
+TEST(PopulationArenaTest, RowsAreIndependentSlices)
+{
+    scheduling::PopulationArena arena(3, 4);
+    EXPECT_EQ(arena.capacity(), 3);
+    EXPECT_EQ(arena.chromosome_size(), 4);
+
+    arena.assign(0, {{1, 2, 3, 4}, 10});
+    arena.assign(2, {{4, 3, 2, 1}, 20});
+    arena.chromosome(1)[0] = 7;
+    arena.fitness(1)       = 30;
+
+    EXPECT_EQ(arena.individual(0).chromosome,
+              (scheduling::Chromosome{1, 2, 3, 4}));
+    EXPECT_EQ(arena.individual(2).chromosome,
+              (scheduling::Chromosome{4, 3, 2, 1}));
+    EXPECT_EQ(arena.chromosome(1)[0], 7);
+    EXPECT_EQ(arena.fitness(2), 20);
+
+    scheduling::PopulationArena other(2, 4);
+    other.copy(1, arena, 2);
+    EXPECT_EQ(other.individual(1).chromosome,
+              (scheduling::Chromosome{4, 3, 2, 1}));
+    EXPECT_EQ(other.fitness(1), 20);
+}
+
+TEST(PopulationArenaTest, InPlaceOperatorsKeepValidChromosomes)
+{
+    scheduling::JobShopInstance instance;
+    instance.generate_instance(10, 5);
+    scheduling::CompiledInstance compiled(instance);
+
+    const size_t                size = compiled.num_ops();
+    scheduling::PopulationArena parents(2, size);
+    scheduling::PopulationArena children(2, size);
+
+    for (int i = 0; i < 50; i++) {
+        parents.assign(0, scheduling::GAAlgorithm::encode(compiled));
+        parents.assign(1, scheduling::GAAlgorithm::encode(compiled));
+        scheduling::GAAlgorithm::crossover(parents.chromosome(0),
+                                           parents.chromosome(1),
+                                           children.chromosome(0),
+                                           children.chromosome(1));
+
+        // children hold the same genes as their parents, in another order
+        for (size_t row = 0; row < 2; row++) {
+            auto genes  = parents.individual(0).chromosome;
+            auto child  = children.individual(row).chromosome;
+            std::ranges::sort(genes);
+            std::ranges::sort(child);
+            EXPECT_EQ(child, genes);
+        }
+
+        children.fitness(0) = scheduling::GAAlgorithm::mutation(
+            children.chromosome(0), compiled);
+        EXPECT_EQ(children.fitness(0),
+                  scheduling::decode_makespan(children.chromosome(0),
+                                              compiled));
+    }
+
+    // the tournament picks one of the rows
+    const std::vector<scheduling::Fitness> fitness{5, 3, 9, 3, 7};
+    for (int i = 0; i < 20; i++) {
+        EXPECT_LT(scheduling::GAAlgorithm::tournament_selection(fitness),
+                  fitness.size());
+    }
+}
+
+TEST(PopulationArenaTest, SmallPopulationsEvolve)
+{
+    scheduling::JobShopInstance instance;
+    instance.generate_instance(6, 4);
+    scheduling::CompiledInstance compiled(instance);
+
+    // fewer individuals than the elite and the left out worst ones
+    for (int population_size : {1, 2, 5, 15}) {
+        scheduling::Incumbent   incumbent;
+        scheduling::GAAlgorithm ga(1, 60, population_size);
+        ga.set_generation_limit(10);
+        ga.solve(compiled, incumbent);
+
+        ASSERT_EQ(ga.populations().size(), 1);
+        const auto& population = ga.populations()[0];
+        EXPECT_GE(population.size(), population_size);
+        EXPECT_LE(population.size(), population_size + 1);
+        for (const auto& individual : population) {
+            EXPECT_EQ(scheduling::decode_makespan(individual.chromosome,
+                                                  compiled),
+                      individual.fitness);
+        }
+    }
+    EXPECT_THROW(scheduling::GAAlgorithm(1, 60, 0), std::invalid_argument);
+}
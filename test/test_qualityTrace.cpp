@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "incumbent.hpp"
+#include "qualityTrace.hpp"
+#include "solution.hpp"
+
+using Point = scheduling::QualityTrace::Point;
+
+TEST(QualityTraceTest, PrimalIntegral)
+{
+    // gap 1 until 1s, then (120 - 100) / 120 until 3s, then 0
+    const std::vector<Point> points{{1.0, 120}, {3.0, 100}};
+    EXPECT_DOUBLE_EQ(
+        scheduling::QualityTrace::primal_integral(points, 100, 5.0),
+        1.0 + 2.0 * 20.0 / 120.0);
+
+    // only the part of the trace before the horizon counts
+    EXPECT_DOUBLE_EQ(
+        scheduling::QualityTrace::primal_integral(points, 100, 2.0),
+        1.0 + 20.0 / 120.0);
+
+    // no solution at all
+    EXPECT_DOUBLE_EQ(scheduling::QualityTrace::primal_integral({}, 100, 4.0),
+                     4.0);
+}
+
+TEST(QualityTraceTest, TimeToTarget)
+{
+    const std::vector<Point> points{{0.5, 130}, {2.0, 110}, {4.0, 101}};
+    EXPECT_DOUBLE_EQ(*scheduling::QualityTrace::time_to_target(points, 110),
+                     2.0);
+    EXPECT_DOUBLE_EQ(*scheduling::QualityTrace::time_to_target(points, 105),
+                     4.0);
+    EXPECT_FALSE(scheduling::QualityTrace::time_to_target(points, 100));
+    EXPECT_EQ(*scheduling::QualityTrace::final_makespan(points), 101);
+    EXPECT_FALSE(scheduling::QualityTrace::final_makespan({}));
+}
+
+TEST(QualityTraceTest, RecordsIncumbentImprovements)
+{
+    scheduling::QualityTrace trace;
+    scheduling::Incumbent    incumbent;
+    incumbent.set_observer(
+        [&trace](scheduling::Fitness makespan) { trace.record(makespan); });
+    trace.start();
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&incumbent, t]() {
+            for (scheduling::Fitness makespan = 1000 - t; makespan > 500;
+                 makespan -= 4) {
+                scheduling::Solution solution;
+                solution.makespan = makespan;
+                incumbent.publish(std::move(solution));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    const auto points = trace.points();
+    ASSERT_FALSE(points.empty());
+    EXPECT_EQ(points.back().makespan, incumbent.makespan());
+    for (size_t i = 1; i < points.size(); ++i) {
+        EXPECT_LT(points[i].makespan, points[i - 1].makespan);
+        EXPECT_GE(points[i].seconds, points[i - 1].seconds);
+    }
+}
@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "random.hpp"
+
+namespace {
+
+std::vector<std::uint64_t> draw(int count)
+{
+    std::vector<std::uint64_t> values;
+    for (int i = 0; i < count; i++) {
+        values.push_back(scheduling::thread_rng()());
+    }
+    return values;
+}
+
+}   // namespace
+
+TEST(RandomTest, MasterSeedIsReproducible)
+{
+    scheduling::set_master_seed(12345);
+    scheduling::set_thread_stream(3);
+    auto first = draw(16);
+
+    scheduling::set_master_seed(12345);
+    scheduling::set_thread_stream(3);
+    EXPECT_EQ(draw(16), first);
+
+    scheduling::set_master_seed(54321);
+    scheduling::set_thread_stream(3);
+    EXPECT_NE(draw(16), first);
+}
+
+TEST(RandomTest, ThreadStreamsAreDeterministicAndDistinct)
+{
+    scheduling::set_master_seed(2024);
+
+    std::vector<std::vector<std::uint64_t>> values(4);
+    std::vector<std::thread>                threads;
+    for (int i = 0; i < 4; i++) {
+        threads.emplace_back([i, &values]() {
+            scheduling::set_thread_stream(i);
+            values[i] = draw(8);
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (int i = 0; i < 4; i++) {
+        scheduling::set_thread_stream(i);
+        EXPECT_EQ(draw(8), values[i]);
+        for (int j = i + 1; j < 4; j++) {
+            EXPECT_NE(values[i], values[j]);
+        }
+    }
+}
+
+TEST(RandomTest, ScopedStreamRestoresTheEngine)
+{
+    scheduling::set_master_seed(7);
+    scheduling::set_thread_stream(1);
+    const auto expected = draw(8);
+
+    scheduling::set_thread_stream(1);
+    auto values = draw(4);
+    std::vector<std::uint64_t> task_values;
+    {
+        const scheduling::ScopedThreadStream stream(
+            scheduling::task_stream(1, 5));
+        task_values = draw(4);
+    }
+    {
+        const scheduling::ScopedThreadStream stream(
+            scheduling::task_stream(1, 5));
+        EXPECT_EQ(draw(4), task_values);
+    }
+    const auto rest = draw(4);
+    values.insert(values.end(), rest.begin(), rest.end());
+    EXPECT_EQ(values, expected);
+}
@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include "compiledInstance.hpp"
+#include "jobShopInstance.hpp"
+#include "snapshot.hpp"
+#include "solution.hpp"
+#include "solutionConstructor.hpp"
+
+namespace {
+
+std::string temp_path(const std::string& name)
+{
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+}   // namespace
+
+TEST(SnapshotTest, InstanceRoundTrip)
+{
+    scheduling::JobShopInstance instance;
+    instance.generate_instance(6, 4);
+    const std::string path = temp_path("instance.jsssnap");
+    scheduling::save_snapshot(path, instance);
+
+    const scheduling::SnapshotFile snapshot(path);
+    EXPECT_EQ(snapshot.num_jobs(), 6);
+    EXPECT_EQ(snapshot.num_machines(), 4);
+    EXPECT_EQ(snapshot.num_ops(), 24);
+    EXPECT_FALSE(snapshot.has_solution());
+    EXPECT_TRUE(snapshot.chromosome().empty());
+
+    const scheduling::CompiledInstance compiled(instance);
+    EXPECT_TRUE(std::ranges::equal(snapshot.op_machines(),
+                                   compiled.op_machines()));
+    EXPECT_TRUE(std::ranges::equal(snapshot.op_durations(),
+                                   compiled.op_durations()));
+
+    scheduling::JobShopInstance restored;
+    snapshot.to_instance(restored);
+    ASSERT_EQ(restored.jobs().size(), instance.jobs().size());
+    for (const auto& [job_id, job] : instance.jobs()) {
+        const auto& restored_job = restored.jobs().at(job_id);
+        EXPECT_EQ(restored_job.due_date, job.due_date);
+        ASSERT_EQ(restored_job.steps.size(), job.steps.size());
+        for (const auto& [step_id, step] : job.steps) {
+            EXPECT_EQ(restored_job.steps.at(step_id).machine_id,
+                      step.machine_id);
+            EXPECT_EQ(restored_job.steps.at(step_id).duration, step.duration);
+        }
+    }
+}
+
+TEST(SnapshotTest, SolutionRoundTrip)
+{
+    scheduling::JobShopInstance instance;
+    instance.generate_instance(8, 5);
+    scheduling::SolutionConstructor constructor;
+    constructor.convert_from_instance(instance);
+    const scheduling::Solution solution = constructor.schedule();
+
+    const std::string path = temp_path("solution.jsssnap");
+    scheduling::save_snapshot(path, instance, &solution);
+
+    const scheduling::SnapshotFile snapshot(path);
+    ASSERT_TRUE(snapshot.has_solution());
+    EXPECT_EQ(snapshot.makespan(), solution.makespan);
+    // the constructor leaves no chromosome, one is derived
+    EXPECT_EQ(snapshot.chromosome().size(), 40);
+
+    const scheduling::CompiledInstance compiled(instance);
+    const scheduling::Solution restored = snapshot.to_solution(compiled);
+    EXPECT_LE(restored.makespan, solution.makespan);
+    EXPECT_TRUE(std::ranges::equal(restored.chromo, snapshot.chromosome()));
+    for (scheduling::OpID op = 0; op < solution.num_ops(); ++op) {
+        EXPECT_LE(restored.start_times[op], solution.start_times[op]);
+    }
+}
+
+TEST(SnapshotTest, RejectsMalformedFiles)
+{
+    scheduling::JobShopInstance instance;
+    instance.generate_instance(3, 3);
+    const std::string path = temp_path("malformed.jsssnap");
+    scheduling::save_snapshot(path, instance);
+
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 8);
+    EXPECT_THROW(scheduling::SnapshotFile{path}, std::runtime_error);
+
+    std::ofstream(path, std::ios::binary | std::ios::trunc)
+        << "3 3\n0 1 1 2 2 3\n";
+    EXPECT_THROW(scheduling::SnapshotFile{path}, std::runtime_error);
+
+    // no schedule to restore
+    scheduling::save_snapshot(path, instance);
+    const scheduling::SnapshotFile     instance_only(path);
+    const scheduling::CompiledInstance compiled(instance);
+    EXPECT_THROW(instance_only.to_solution(compiled), std::runtime_error);
+}
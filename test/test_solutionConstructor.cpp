@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "compiledInstance.hpp"
+#include "disjunctiveGraph.hpp"
+#include "jobShopInstance.hpp"
+#include "solutionConstructor.hpp"
+
+TEST(SolutionConstructorTest, SchedulesAreFeasible)
+{
+    scheduling::JobShopInstance instance;
+    instance.generate_instance(20, 8);
+    scheduling::CompiledInstance compiled(instance);
+
+    scheduling::SolutionConstructor constructor;
+    constructor.convert_from_instance(compiled);
+
+    std::vector<scheduling::TimeStamp> start_times;
+    for (float alpha : {0.0F, 0.3F, 1.0F}) {
+        constructor.set_alpha(alpha);
+        for (int i = 0; i < 5; i++) {
+            auto makespan = constructor.schedule(start_times);
+            ASSERT_EQ(start_times.size(), compiled.num_ops());
+
+            // job order
+            for (scheduling::JobID job = 0; job < compiled.num_jobs(); job++) {
+                for (auto op = compiled.job_begin(job) + 1;
+                     op < compiled.job_end(job); op++) {
+                    auto previous_end = start_times[op - 1] +
+                                        compiled.op_durations()[op - 1];
+                    EXPECT_GE(start_times[op], previous_end);
+                }
+            }
+
+            // no overlap on the machines, the graph of the start times is
+            // never longer
+            auto graph = scheduling::DisjunctiveGraph::from_start_times(
+                start_times, compiled);
+            for (scheduling::MachineID m = 0; m < compiled.num_machines();
+                 m++) {
+                auto sequence = graph.machine_sequence(m);
+                for (size_t pos = 1; pos < sequence.size(); pos++) {
+                    EXPECT_GE(start_times[sequence[pos]],
+                              start_times[sequence[pos - 1]] +
+                                  compiled.op_durations()[sequence[pos - 1]]);
+                }
+            }
+            EXPECT_LE(graph.makespan(), makespan);
+            EXPECT_GE(makespan, compiled.lower_bound());
+        }
+    }
+}
+
+TEST(SolutionConstructorTest, SolutionMatchesStartTimes)
+{
+    scheduling::JobShopInstance instance;
+    instance.generate_instance(10, 5);
+
+    scheduling::SolutionConstructor constructor;
+    constructor.convert_from_instance(instance);
+    auto solution = constructor.schedule();
+
+    EXPECT_EQ(solution.num_ops(), 50);
+    EXPECT_EQ(solution.num_machines(), 5);
+    for (scheduling::MachineID machine = 0; machine < 5; ++machine) {
+        scheduling::TimeStamp last_end = 0;
+        EXPECT_EQ(solution.machine_sequence(machine).size(), 10);
+        for (scheduling::OpID op : solution.machine_sequence(machine)) {
+            EXPECT_GE(solution.start_times[op], last_end);
+            last_end = solution.end_times[op];
+        }
+    }
+}
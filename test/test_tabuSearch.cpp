@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "algorithm.hpp"
+#include "compiledInstance.hpp"
+#include "disjunctiveGraph.hpp"
+#include "incumbent.hpp"
+#include "jobShopInstance.hpp"
+#include "tabuSearch.hpp"
+
+TEST(TabuSearchTest, CriticalBlockMovesKeepGraphAcyclic)
+{
+    scheduling::JobShopInstance instance;
+    instance.generate_instance(10, 6);
+    scheduling::CompiledInstance compiled(instance);
+
+    std::vector<scheduling::TabuSearchAlgorithm::Move> moves;
+    for (int i = 0; i < 10; i++) {
+        auto graph = scheduling::DisjunctiveGraph::from_chromosome(
+            scheduling::GAAlgorithm::encode(compiled).chromosome, compiled);
+        scheduling::TabuSearchAlgorithm::generate_moves(
+            graph, scheduling::TabuSearchAlgorithm::Neighborhood::N7, moves);
+
+        for (const auto& move : moves) {
+            EXPECT_EQ(move.estimate,
+                      scheduling::TabuSearchAlgorithm::estimate_move(
+                          graph, move.machine, move.from, move.to));
+
+            auto copy = graph;
+            copy.move_on_machine(move.machine, move.from, move.to);
+            EXPECT_TRUE(copy.update());
+        }
+    }
+}
+
+TEST(TabuSearchTest, SolveImprovesIncumbent)
+{
+    scheduling::JobShopInstance instance;
+    instance.generate_instance(10, 5);
+    scheduling::CompiledInstance compiled(instance);
+
+    auto initial = scheduling::GAAlgorithm::encode(compiled);
+    scheduling::Incumbent incumbent(
+        scheduling::GAAlgorithm::decode(initial.chromosome, compiled));
+
+    scheduling::TabuSearchAlgorithm tabu_search(2, 1);
+    tabu_search.solve(compiled, incumbent);
+    EXPECT_LE(incumbent.makespan(), initial.fitness);
+
+    // the published schedule is feasible and has the published makespan
+    auto graph = scheduling::DisjunctiveGraph::from_solution(
+        *incumbent.snapshot(), compiled);
+    EXPECT_EQ(graph.makespan(), incumbent.makespan());
+}
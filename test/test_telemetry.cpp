@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "incumbent.hpp"
+#include "telemetry.hpp"
+
+namespace {
+
+std::uint64_t total(scheduling::Counter counter)
+{
+    return scheduling::counter_totals()[static_cast<size_t>(counter)];
+}
+
+}   // namespace
+
+TEST(TelemetryTest, SumsLiveAndExitedThreads)
+{
+    const auto before = total(scheduling::Counter::DECODES);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([]() {
+            for (int i = 0; i < 1000; ++i) {
+                scheduling::count(scheduling::Counter::DECODES);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    scheduling::count(scheduling::Counter::DECODES, 10);
+
+    EXPECT_EQ(total(scheduling::Counter::DECODES) - before, 4010);
+}
+
+TEST(TelemetryTest, TimedLockCountsContention)
+{
+    const auto before = total(scheduling::Counter::LOCK_WAIT_NS);
+
+    std::mutex                   mutex;
+    std::unique_lock<std::mutex> held(mutex);
+    std::thread                  waiter([&mutex]() {
+        std::unique_lock<std::mutex> lock(mutex, std::defer_lock);
+        scheduling::timed_lock(lock);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    held.unlock();
+    waiter.join();
+
+    EXPECT_GE(total(scheduling::Counter::LOCK_WAIT_NS) - before, 10'000'000);
+
+    // no contention, nothing counted
+    const auto uncontended = total(scheduling::Counter::LOCK_WAIT_NS);
+    std::unique_lock<std::mutex> lock(mutex, std::defer_lock);
+    scheduling::timed_lock(lock);
+    EXPECT_EQ(total(scheduling::Counter::LOCK_WAIT_NS), uncontended);
+}
+
+TEST(TelemetryTest, ReporterWritesJsonLines)
+{
+    std::ostringstream    out;
+    scheduling::Incumbent incumbent;
+    {
+        scheduling::TelemetryReporter reporter(
+            out, std::chrono::milliseconds(5), incumbent);
+        scheduling::count(scheduling::Counter::GENERATIONS, 3);
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    }
+
+    std::istringstream lines(out.str());
+    std::string        line;
+    std::string        last;
+    int                num_lines = 0;
+    while (std::getline(lines, line)) {
+        EXPECT_EQ(line.front(), '{');
+        EXPECT_EQ(line.back(), '}');
+        last = line;
+        ++num_lines;
+    }
+    EXPECT_GE(num_lines, 2);
+    EXPECT_NE(last.find("\"makespan\": null"), std::string::npos);
+    EXPECT_NE(last.find("\"generations\": 3,"), std::string::npos);
+}
@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include "threadPool.hpp"
+
+TEST(ThreadPoolTest, ParallelForVisitsEachIndexOnce)
+{
+    scheduling::ThreadPool pool(4);
+
+    std::vector<std::atomic<int>> visits(1000);
+    pool.parallel_for(visits.size(), [&](size_t i) { visits[i]++; }, 7);
+    for (const auto& visit : visits) {
+        EXPECT_EQ(visit.load(), 1);
+    }
+}
+
+TEST(ThreadPoolTest, NestedParallelForFromTasks)
+{
+    scheduling::ThreadPool pool(3);
+
+    std::atomic<int> total{0};
+    pool.parallel_for(8, [&](size_t) {
+        pool.parallel_for(100, [&](size_t) { total++; });
+    });
+    EXPECT_EQ(total.load(), 800);
+}
+
+TEST(ThreadPoolTest, SubmittedTasksAreCounted)
+{
+    std::atomic<int> done{0};
+    {
+        scheduling::ThreadPool pool(2);
+        for (int i = 0; i < 50; i++) {
+            pool.submit([&]() { done++; });
+        }
+        while (done.load() < 50) {
+        }
+
+        std::uint64_t num_tasks = 0;
+        for (const auto& stat : pool.stats()) {
+            num_tasks += stat.tasks;
+        }
+        EXPECT_EQ(num_tasks, 50);
+        EXPECT_EQ(pool.current_worker(), -1);
+    }
+    EXPECT_EQ(done.load(), 50);
+}
+
+TEST(ThreadPoolTest, JobsRunTogetherWithTheirParallelFors)
+{
+    scheduling::ThreadPool pool(2);
+
+    // each job waits for the other, so both must run on workers of their
+    // own, and their parallel_fors must not pick up the other job
+    std::atomic<int> started{0};
+    std::atomic<int> total{0};
+    std::atomic<int> done{0};
+    for (int i = 0; i < 2; i++) {
+        pool.submit_job([&]() {
+            started++;
+            while (started.load() < 2) {
+            }
+            pool.parallel_for(100, [&](size_t) { total++; });
+            done++;
+        });
+    }
+    while (done.load() < 2) {
+    }
+    EXPECT_EQ(total.load(), 200);
+}
+
+TEST(ThreadPoolTest, IdleWorkersRunTheTasksOfAJob)
+{
+    scheduling::ThreadPool pool(3);
+
+    // the job keeps its worker, the other two are idle and steal the tasks
+    // it submits
+    std::atomic<int>              job_worker{-1};
+    std::vector<std::atomic<int>> tasks_of(pool.num_workers());
+    std::atomic<bool>             done{false};
+    pool.submit_job([&]() {
+        job_worker = pool.current_worker();
+        pool.parallel_for(64, [&](size_t) {
+            tasks_of[pool.current_worker()]++;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        });
+        done = true;
+    });
+    while (!done.load()) {
+    }
+
+    int helpers = 0;
+    int total   = 0;
+    for (int worker = 0; worker < pool.num_workers(); worker++) {
+        total += tasks_of[worker].load();
+        if (worker != job_worker.load() && tasks_of[worker].load() > 0) {
+            helpers++;
+        }
+    }
+    EXPECT_EQ(total, 64);
+    EXPECT_GE(helpers, 1);
+}